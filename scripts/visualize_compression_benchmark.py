@@ -8,47 +8,44 @@ csv_files = glob.glob('compression_benchmark_*_compression_benchmark.csv')
 dfs = [pd.read_csv(f) for f in csv_files]
 df = pd.concat(dfs, ignore_index=True)
 
-# Map algorithm numbers to names
-algo_map = {0: 'Uncompressed', 1: 'Snappy', 2: 'Gzip', 3: 'Brotli', 4: 'Zstd'}
-df['algorithm'] = df['algorithm'].map(algo_map)
+# Each CSV holds every codec at its default level, plus ZSTD and LZ4 at levels
+# 1 to 19, for both data types and every encoding they support. Codecs are
+# compared at their default level, one panel per data type and encoding.
+defaults = df[df['compression_level'].isna()]
 
 # Set up the plot style
 sns.set_style("whitegrid")
 
+def plot_codecs(y, title, ylabel, filename):
+    g = sns.catplot(data=defaults, kind='bar', x='num_columns', y=y, hue='algorithm',
+                    col='data_type', row='encoding', sharey=False, height=4, aspect=1.5)
+    g.set(yscale='log')
+    g.set_axis_labels('Number of Columns', ylabel)
+    g.fig.suptitle(title, y=1.02)
+    g.savefig(filename)
+    plt.close(g.fig)
+
 # Plot 1: Encoding time
-plt.figure(figsize=(15, 10))
-sns.barplot(x='num_columns', y='encoding_time_ms', hue='algorithm', data=df)
-plt.title('Encoding Time by Compression Algorithm and Number of Columns')
-plt.ylabel('Encoding Time (ms)')
-plt.xlabel('Number of Columns')
-plt.yscale('log')
-plt.legend(title='Algorithm')
-plt.tight_layout()
-plt.savefig('./temp/encoding_time.png')
-plt.close()
+plot_codecs('encoding_time_ms', 'Encoding Time by Compression Algorithm and Number of Columns',
+            'Encoding Time (ms)', './temp/encoding_time.png')
 
 # Plot 2: Decoding time
-plt.figure(figsize=(15, 10))
-sns.barplot(x='num_columns', y='decoding_time_ms', hue='algorithm', data=df)
-plt.title('Decoding Time by Compression Algorithm and Number of Columns')
-plt.ylabel('Decoding Time (ms)')
-plt.xlabel('Number of Columns')
-plt.yscale('log')
-plt.legend(title='Algorithm')
-plt.tight_layout()
-plt.savefig('./temp/decoding_time.png')
-plt.close()
+plot_codecs('decoding_time_ms', 'Decoding Time by Compression Algorithm and Number of Columns',
+            'Decoding Time (ms)', './temp/decoding_time.png')
 
 # Plot 3: Compressed size
-plt.figure(figsize=(15, 10))
-sns.barplot(x='num_columns', y='compressed_size_mb', hue='algorithm', data=df)
-plt.title('Compressed Size by Compression Algorithm and Number of Columns')
-plt.ylabel('Compressed Size (MB)')
-plt.xlabel('Number of Columns')
-plt.yscale('log')
-plt.legend(title='Algorithm')
-plt.tight_layout()
-plt.savefig('./temp/compressed_size.png')
-plt.close()
-
-print("Plots have been saved as separate PNG files.")
\ No newline at end of file
+plot_codecs('compressed_size_mb', 'Compressed Size by Compression Algorithm and Number of Columns',
+            'Compressed Size (MB)', './temp/compressed_size.png')
+
+# Plot 4: ZSTD and LZ4 levels, PLAIN encoded, at the largest column count
+levels = df[df['compression_level'].notna() & (df['encoding'] == 'plain') &
+            (df['num_columns'] == df['num_columns'].max())]
+for y, ylabel, filename in [('compressed_size_mb', 'Compressed Size (MB)', './temp/level_compressed_size.png'),
+                            ('encoding_time_ms', 'Encoding Time (ms)', './temp/level_encoding_time.png')]:
+    g = sns.relplot(data=levels, kind='line', x='compression_level', y=y, hue='algorithm', col='data_type',
+                    marker='o', facet_kws={'sharey': False}, height=4, aspect=1.5)
+    g.set_axis_labels('Compression Level', ylabel)
+    g.savefig(filename)
+    plt.close(g.fig)
+
+print("Plots have been saved as separate PNG files.")
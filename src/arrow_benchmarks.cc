@@ -4,17 +4,21 @@
 #include <parquet/arrow/writer.h>
 #include <chrono>
 #include <fstream>
+#include <iostream>
 #include "arrow_benchmarks.h"
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
 
 BenchmarkResult BenchmarkMetadata(const std::string& filename) {
     BenchmarkResult result;
 
     auto start = std::chrono::high_resolution_clock::now();
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(filename));
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename));
 
     std::unique_ptr<parquet::arrow::FileReader> reader;
-    auto status = parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader);
+    auto status = parquet::arrow::OpenFile(infile, BenchmarkMemoryPool(), &reader);
     assert(status.ok());
 
     result.decode_time = std::chrono::duration<double, std::milli>(
@@ -27,13 +31,19 @@ BenchmarkResult BenchmarkMetadata(const std::string& filename) {
 
 void WriteBenchmarkResults(const std::vector<BenchmarkResult>& results, const std::string& filename) {
     std::ofstream file(filename);
-    file << "num_columns,decode_time_ms,size_mb\n";
+    file << "num_columns,decode_time_ms,size_mb,memory_pool\n";
     for (const auto& result : results) {
-        file << result.num_columns << "," << result.decode_time << "," << result.size << "\n";
+        file << result.num_columns << "," << result.decode_time << "," << result.size << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     std::vector<int> column_counts = {10, 100, 1000, 10000};
     std::string output_file = "benchmark_decode_and_size.csv";
 
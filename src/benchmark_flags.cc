@@ -0,0 +1,25 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "synthetic_data.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+void PrintGenerationStatsAtExit() {
+    PrintGenerationStats(std::cerr);
+}
+
+}  // namespace
+
+arrow::Status ParseBenchmarkFlags(int* argc, char** argv) {
+    ARROW_RETURN_NOT_OK(ParseIoFlags(argc, argv));
+    ARROW_RETURN_NOT_OK(ParseMemoryPoolFlags(argc, argv));
+    ARROW_RETURN_NOT_OK(ParseSyntheticDataFlags(argc, argv));
+    static bool registered = std::atexit(PrintGenerationStatsAtExit) == 0;
+    if (!registered) {
+        return arrow::Status::UnknownError("Cannot register the generation report");
+    }
+    return arrow::Status::OK();
+}
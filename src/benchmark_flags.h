@@ -0,0 +1,13 @@
+#ifndef BENCHMARK_FLAGS_H
+#define BENCHMARK_FLAGS_H
+
+#include <arrow/status.h>
+
+// Handles the arguments every executable shares and removes them from argv,
+// so the rest can go to benchmark::Initialize or the executable's own parsing:
+// the I/O flags of ParseIoFlags, --pool=<backend> of ParseMemoryPoolFlags and
+// --seed=<n> of ParseSyntheticDataFlags. Also arranges for
+// PrintGenerationStats to report to stderr when the process exits.
+arrow::Status ParseBenchmarkFlags(int* argc, char** argv);
+
+#endif  // BENCHMARK_FLAGS_H
@@ -0,0 +1,734 @@
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include <arrow/buffer.h>
+#include <arrow/io/file.h>
+#include <arrow/io/memory.h>
+#include <arrow/util/future.h>
+#include <arrow/util/io_util.h>
+#include <arrow/util/thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<IoBackend> default_backend{IoBackend::PREAD};
+std::atomic<bool> cold_cache_mode{false};
+
+std::mutex default_simulated_storage_mutex;
+std::optional<SimulatedStorageOptions> default_simulated_storage;
+
+// Parses the value of a --name=value argument, or returns false if `arg` is a
+// different argument.
+bool ParseFlagValue(const std::string& arg, const std::string& name, std::string* value) {
+    std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    *value = arg.substr(prefix.size());
+    return true;
+}
+
+#ifdef __linux__
+
+// A RandomAccessFile that reads through its own io_uring instance, set up with
+// the raw system calls so there is no liburing dependency. ReadManyAsync
+// submits all requested ranges before waiting for any of them, which is what
+// the Parquet reader's pre-buffering issues for the column chunks it needs.
+// The ring serves one batch at a time; concurrent callers wait for each other.
+class IoUringFile : public arrow::io::RandomAccessFile {
+public:
+    static constexpr unsigned kQueueDepth = 64;
+    // A single SQE reads at most this much; longer reads are split.
+    static constexpr int64_t kMaxReadSize = 1 << 30;
+
+    static arrow::Result<std::shared_ptr<IoUringFile>> Open(const std::string& filename) {
+        std::shared_ptr<IoUringFile> file(new IoUringFile());
+        file->fd_ = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file->fd_ < 0) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to open ", filename);
+        }
+        struct stat st;
+        if (fstat(file->fd_, &st) != 0) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to stat ", filename);
+        }
+        file->size_ = st.st_size;
+        ARROW_RETURN_NOT_OK(file->SetUpRing());
+        return file;
+    }
+
+    ~IoUringFile() override { (void)Close(); }
+
+    arrow::Status Close() override {
+        if (ring_fd_ >= 0) {
+            if (sqes_ != MAP_FAILED) {
+                munmap(sqes_, sqes_size_);
+            }
+            if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+                munmap(cq_ptr_, cq_size_);
+            }
+            if (sq_ptr_ != MAP_FAILED) {
+                munmap(sq_ptr_, sq_size_);
+            }
+            close(ring_fd_);
+            ring_fd_ = -1;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        return arrow::Status::OK();
+    }
+
+    bool closed() const override { return fd_ < 0; }
+
+    arrow::Result<int64_t> Tell() const override { return position_.load(); }
+
+    arrow::Status Seek(int64_t position) override {
+        position_ = position;
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<int64_t> GetSize() override { return size_; }
+
+    arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+        ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position_, nbytes, out));
+        position_ += bytes_read;
+        return bytes_read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+        position_ += buffer->size();
+        return buffer;
+    }
+
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override {
+        std::vector<ReadRequest> requests = {{position, ClampLength(position, nbytes), static_cast<uint8_t*>(out)}};
+        ARROW_RETURN_NOT_OK(ReadBatch(&requests));
+        return requests[0].done;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateResizableBuffer(ClampLength(position, nbytes)));
+        ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position, buffer->size(), buffer->mutable_data()));
+        ARROW_RETURN_NOT_OK(buffer->Resize(bytes_read, false));
+        return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+    }
+
+    std::vector<arrow::Future<std::shared_ptr<arrow::Buffer>>> ReadManyAsync(
+            const arrow::io::IOContext& io_context, const std::vector<arrow::io::ReadRange>& ranges) override {
+        std::vector<std::unique_ptr<arrow::ResizableBuffer>> buffers;
+        std::vector<ReadRequest> requests;
+        arrow::Status status;
+        for (const auto& range : ranges) {
+            auto buffer = arrow::AllocateResizableBuffer(ClampLength(range.offset, range.length), io_context.pool());
+            if (!buffer.ok()) {
+                status = buffer.status();
+                break;
+            }
+            buffers.push_back(std::move(*buffer));
+            requests.push_back({range.offset, buffers.back()->size(), buffers.back()->mutable_data()});
+        }
+        if (status.ok()) {
+            status = ReadBatch(&requests);
+        }
+
+        std::vector<arrow::Future<std::shared_ptr<arrow::Buffer>>> futures;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (!status.ok()) {
+                futures.push_back(arrow::Future<std::shared_ptr<arrow::Buffer>>::MakeFinished(status));
+                continue;
+            }
+            status = buffers[i]->Resize(requests[i].done, false);
+            futures.push_back(arrow::Future<std::shared_ptr<arrow::Buffer>>::MakeFinished(
+                status.ok() ? arrow::Result<std::shared_ptr<arrow::Buffer>>(std::move(buffers[i]))
+                            : arrow::Result<std::shared_ptr<arrow::Buffer>>(status)));
+        }
+        return futures;
+    }
+
+private:
+    struct ReadRequest {
+        int64_t offset;
+        int64_t length;
+        uint8_t* out;
+        int64_t done = 0;
+    };
+
+    IoUringFile() = default;
+
+    int64_t ClampLength(int64_t position, int64_t nbytes) const {
+        return std::max<int64_t>(0, std::min(nbytes, size_ - position));
+    }
+
+    arrow::Status SetUpRing() {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, kQueueDepth, &params));
+        if (ring_fd_ < 0) {
+            return arrow::internal::IOErrorFromErrno(errno, "io_uring_setup failed");
+        }
+        sq_entries_ = params.sq_entries;
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+        sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                       IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to map the io_uring submission queue");
+        }
+        cq_ptr_ = single_mmap ? sq_ptr_
+                              : mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to map the io_uring completion queue");
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                     IORING_OFF_SQES);
+        if (sqes_ == MAP_FAILED) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to map the io_uring SQEs");
+        }
+
+        auto* sq = static_cast<uint8_t*>(sq_ptr_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<uint8_t*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return arrow::Status::OK();
+    }
+
+    void QueueRead(const ReadRequest& request, uint64_t user_data) {
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd_;
+        sqe->off = request.offset + request.done;
+        sqe->addr = reinterpret_cast<uint64_t>(request.out + request.done);
+        sqe->len = static_cast<uint32_t>(std::min(request.length - request.done, kMaxReadSize));
+        sqe->user_data = user_data;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    // Reads every request to completion or EOF, keeping up to kQueueDepth reads
+    // in flight. Short reads are resubmitted for the remainder.
+    arrow::Status ReadBatch(std::vector<ReadRequest>* requests) {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        if (closed()) {
+            return arrow::Status::Invalid("Operation on closed file");
+        }
+        std::deque<size_t> pending;
+        for (size_t i = 0; i < requests->size(); ++i) {
+            if ((*requests)[i].length > 0) {
+                pending.push_back(i);
+            }
+        }
+        unsigned in_flight = 0;
+        // In the submission ring but not yet consumed by the kernel, which may
+        // take fewer than it is offered
+        unsigned queued = 0;
+        while (!pending.empty() || queued > 0 || in_flight > 0) {
+            while (!pending.empty() && in_flight + queued < sq_entries_) {
+                QueueRead((*requests)[pending.front()], pending.front());
+                pending.pop_front();
+                ++queued;
+            }
+            int ret;
+            do {
+                ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, queued, 1,
+                                               IORING_ENTER_GETEVENTS, nullptr, 0));
+            } while (ret < 0 && errno == EINTR);
+            if (ret < 0 || (ret == 0 && queued > 0 && in_flight == 0)) {
+                int error = ret < 0 ? errno : EAGAIN;
+                WithdrawQueued(queued);
+                DrainInFlight(in_flight);
+                return arrow::internal::IOErrorFromErrno(error, "io_uring_enter failed");
+            }
+            queued -= static_cast<unsigned>(ret);
+            in_flight += static_cast<unsigned>(ret);
+
+            unsigned head = *cq_head_;
+            while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                auto& request = (*requests)[cqe.user_data];
+                int res = cqe.res;
+                ++head;
+                --in_flight;
+                if (res < 0) {
+                    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+                    WithdrawQueued(queued);
+                    DrainInFlight(in_flight);
+                    return arrow::internal::IOErrorFromErrno(-res, "io_uring read failed");
+                }
+                request.done += res;
+                if (res > 0 && request.done < request.length) {
+                    pending.push_back(cqe.user_data);
+                }
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+        return arrow::Status::OK();
+    }
+
+    // Takes back the last `queued` entries of the submission ring, which the
+    // kernel has not consumed, so a later batch does not submit them.
+    void WithdrawQueued(unsigned queued) {
+        __atomic_store_n(sq_tail_, *sq_tail_ - queued, __ATOMIC_RELEASE);
+    }
+
+    // Waits out reads still in flight after an error, so none of them writes into
+    // buffers the caller is about to free.
+    void DrainInFlight(unsigned in_flight) {
+        while (in_flight > 0) {
+            if (syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                errno != EINTR) {
+                return;
+            }
+            unsigned head = *cq_head_;
+            while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                ++head;
+                --in_flight;
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    int fd_ = -1;
+    int64_t size_ = 0;
+    std::atomic<int64_t> position_{0};
+
+    std::mutex ring_mutex_;
+    int ring_fd_ = -1;
+    unsigned sq_entries_ = 0;
+    void* sq_ptr_ = MAP_FAILED;
+    void* cq_ptr_ = MAP_FAILED;
+    void* sqes_ = MAP_FAILED;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    size_t sqes_size_ = 0;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+// A RandomAccessFile opened with O_DIRECT, so every read goes to the device.
+// O_DIRECT needs the offset, length and buffer aligned to the logical block
+// size, so each read fills an aligned bounce buffer covering the blocks around
+// the requested range and copies the range out of it.
+class DirectFile : public arrow::io::RandomAccessFile {
+public:
+    // A multiple of the logical block size of common devices, 512 or 4096
+    static constexpr int64_t kAlignment = 4096;
+
+    static arrow::Result<std::shared_ptr<DirectFile>> Open(const std::string& filename) {
+        std::shared_ptr<DirectFile> file(new DirectFile());
+        file->fd_ = open(filename.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+        if (file->fd_ < 0) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to open ", filename, " with O_DIRECT");
+        }
+        struct stat st;
+        if (fstat(file->fd_, &st) != 0) {
+            return arrow::internal::IOErrorFromErrno(errno, "Failed to stat ", filename);
+        }
+        file->size_ = st.st_size;
+        return file;
+    }
+
+    ~DirectFile() override { (void)Close(); }
+
+    arrow::Status Close() override {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        return arrow::Status::OK();
+    }
+
+    bool closed() const override { return fd_ < 0; }
+
+    arrow::Result<int64_t> Tell() const override { return position_.load(); }
+
+    arrow::Status Seek(int64_t position) override {
+        position_ = position;
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<int64_t> GetSize() override { return size_; }
+
+    arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+        ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position_, nbytes, out));
+        position_ += bytes_read;
+        return bytes_read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+        position_ += buffer->size();
+        return buffer;
+    }
+
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override {
+        if (closed()) {
+            return arrow::Status::Invalid("Operation on closed file");
+        }
+        nbytes = std::max<int64_t>(0, std::min(nbytes, size_ - position));
+        if (nbytes == 0) {
+            return 0;
+        }
+        int64_t begin = position / kAlignment * kAlignment;
+        int64_t end = (position + nbytes + kAlignment - 1) / kAlignment * kAlignment;
+        std::unique_ptr<uint8_t, decltype(&std::free)> bounce(
+            static_cast<uint8_t*>(std::aligned_alloc(kAlignment, end - begin)), &std::free);
+        if (!bounce) {
+            return arrow::Status::OutOfMemory("Failed to allocate a ", end - begin, " byte O_DIRECT buffer");
+        }
+        // The last block of the file comes back short, which ends the loop
+        int64_t done = 0;
+        while (begin + done < std::min(end, size_)) {
+            ssize_t ret = pread(fd_, bounce.get() + done, end - begin - done, begin + done);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                return arrow::internal::IOErrorFromErrno(errno, "O_DIRECT read failed");
+            }
+            if (ret == 0) {
+                break;
+            }
+            done += ret;
+        }
+        int64_t bytes_read = std::max<int64_t>(0, std::min(nbytes, done - (position - begin)));
+        std::memcpy(out, bounce.get() + (position - begin), bytes_read);
+        return bytes_read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override {
+        nbytes = std::max<int64_t>(0, std::min(nbytes, size_ - position));
+        ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateResizableBuffer(nbytes));
+        ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position, buffer->size(), buffer->mutable_data()));
+        ARROW_RETURN_NOT_OK(buffer->Resize(bytes_read, false));
+        return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+    }
+
+private:
+    DirectFile() = default;
+
+    int fd_ = -1;
+    int64_t size_ = 0;
+    std::atomic<int64_t> position_{0};
+};
+
+#endif  // __linux__
+
+}  // namespace
+
+const char* IoBackendName(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::PREAD: return "pread";
+        case IoBackend::MMAP: return "mmap";
+        case IoBackend::MEMORY: return "memory";
+        case IoBackend::IO_URING: return "io_uring";
+        case IoBackend::DIRECT: return "direct";
+    }
+    return "unknown";
+}
+
+arrow::Result<IoBackend> ParseIoBackend(const std::string& name) {
+    for (auto backend : {IoBackend::PREAD, IoBackend::MMAP, IoBackend::MEMORY, IoBackend::IO_URING,
+                         IoBackend::DIRECT}) {
+        if (name == IoBackendName(backend)) {
+            return backend;
+        }
+    }
+    return arrow::Status::Invalid("Unknown I/O backend '", name, "', expected pread, mmap, memory, io_uring or direct");
+}
+
+IoBackend DefaultIoBackend() {
+    return default_backend.load();
+}
+
+void SetDefaultIoBackend(IoBackend backend) {
+    default_backend = backend;
+}
+
+bool ColdCacheMode() {
+    return cold_cache_mode.load();
+}
+
+void SetColdCacheMode(bool cold) {
+    cold_cache_mode = cold;
+}
+
+const char* CacheModeName(bool cold) {
+    return cold ? "cold" : "warm";
+}
+
+arrow::Status EvictFromPageCache(const std::string& filename) {
+#ifdef __linux__
+    int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return arrow::internal::IOErrorFromErrno(errno, "Failed to open ", filename);
+    }
+    arrow::Status status;
+    if (fdatasync(fd) != 0) {
+        status = arrow::internal::IOErrorFromErrno(errno, "Failed to sync ", filename);
+    } else if (int err = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED); err != 0) {
+        // posix_fadvise returns the error rather than setting errno
+        status = arrow::internal::IOErrorFromErrno(err, "Failed to evict ", filename, " from the page cache");
+    }
+    close(fd);
+    return status;
+#else
+    return arrow::Status::NotImplemented("Page cache eviction is only available on Linux");
+#endif
+}
+
+arrow::Status PrepareTimedRead(const std::string& filename) {
+    if (!ColdCacheMode()) {
+        return arrow::Status::OK();
+    }
+    return EvictFromPageCache(filename);
+}
+
+arrow::Result<std::shared_ptr<SimulatedStorageFile>> SimulatedStorageFile::Make(
+        std::shared_ptr<arrow::io::RandomAccessFile> file, const SimulatedStorageOptions& options) {
+    ARROW_ASSIGN_OR_RAISE(int64_t size, file->GetSize());
+    return std::shared_ptr<SimulatedStorageFile>(new SimulatedStorageFile(std::move(file), options, size));
+}
+
+arrow::Status SimulatedStorageFile::Close() {
+    return file_->Close();
+}
+
+bool SimulatedStorageFile::closed() const {
+    return file_->closed();
+}
+
+arrow::Result<int64_t> SimulatedStorageFile::Tell() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return position_;
+}
+
+arrow::Status SimulatedStorageFile::Seek(int64_t position) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    position_ = position;
+    return arrow::Status::OK();
+}
+
+arrow::Result<int64_t> SimulatedStorageFile::GetSize() {
+    return size_;
+}
+
+arrow::Result<int64_t> SimulatedStorageFile::Read(int64_t nbytes, void* out) {
+    ARROW_ASSIGN_OR_RAISE(int64_t position, Tell());
+    ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position, nbytes, out));
+    ARROW_RETURN_NOT_OK(Seek(position + bytes_read));
+    return bytes_read;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> SimulatedStorageFile::Read(int64_t nbytes) {
+    ARROW_ASSIGN_OR_RAISE(int64_t position, Tell());
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position, nbytes));
+    ARROW_RETURN_NOT_OK(Seek(position + buffer->size()));
+    return buffer;
+}
+
+arrow::Result<int64_t> SimulatedStorageFile::ReadAt(int64_t position, int64_t nbytes, void* out) {
+    BeginRequest(position, nbytes);
+    auto result = file_->ReadAt(position, nbytes, out);
+    EndRequest();
+    return result;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> SimulatedStorageFile::ReadAt(int64_t position, int64_t nbytes) {
+    BeginRequest(position, nbytes);
+    auto result = file_->ReadAt(position, nbytes);
+    EndRequest();
+    return result;
+}
+
+IoStats SimulatedStorageFile::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SimulatedStorageFile::ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = IoStats();
+}
+
+void SimulatedStorageFile::BeginRequest(int64_t position, int64_t nbytes) {
+    nbytes = std::max<int64_t>(0, std::min(nbytes, size_ - position));
+    std::unique_lock<std::mutex> lock(mutex_);
+    slot_available_.wait(lock, [this] {
+        return options_.max_concurrent_requests <= 0 || active_requests_ < options_.max_concurrent_requests;
+    });
+    ++active_requests_;
+    ++stats_.requests;
+    stats_.bytes_read += nbytes;
+
+    auto ready = std::chrono::steady_clock::now() + options_.latency;
+    if (options_.bandwidth_bytes_per_second > 0) {
+        // The transfer starts once the first byte is due and earlier transfers
+        // have released the link.
+        auto transfer = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(nbytes) / options_.bandwidth_bytes_per_second));
+        link_free_ = std::max(ready, link_free_) + transfer;
+        ready = link_free_;
+    }
+    lock.unlock();
+    std::this_thread::sleep_until(ready);
+}
+
+void SimulatedStorageFile::EndRequest() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --active_requests_;
+    }
+    slot_available_.notify_one();
+}
+
+std::optional<SimulatedStorageOptions> DefaultSimulatedStorage() {
+    std::lock_guard<std::mutex> lock(default_simulated_storage_mutex);
+    return default_simulated_storage;
+}
+
+void SetDefaultSimulatedStorage(std::optional<SimulatedStorageOptions> options) {
+    std::lock_guard<std::mutex> lock(default_simulated_storage_mutex);
+    default_simulated_storage = options;
+}
+
+arrow::Status ReadFooterLocation(arrow::io::RandomAccessFile* file, int64_t* footer_start, uint32_t* footer_len) {
+    ARROW_ASSIGN_OR_RAISE(int64_t file_size, file->GetSize());
+    if (file_size < 12) {
+        return arrow::Status::Invalid("File of ", file_size, " bytes is too small to be a Parquet file");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto trailer, file->ReadAt(file_size - 8, 8));
+    if (trailer->size() != 8 || std::memcmp(trailer->data() + 4, "PAR1", 4) != 0) {
+        return arrow::Status::Invalid("Not a Parquet file, or the footer is encrypted");
+    }
+    std::memcpy(footer_len, trailer->data(), sizeof(*footer_len));
+    *footer_start = file_size - 8 - *footer_len;
+    if (*footer_start < 4) {
+        return arrow::Status::Invalid("Footer length ", *footer_len, " exceeds the file size");
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> ReadFooterBytes(arrow::io::RandomAccessFile* file) {
+    int64_t footer_start;
+    uint32_t footer_len;
+    ARROW_RETURN_NOT_OK(ReadFooterLocation(file, &footer_start, &footer_len));
+    return file->ReadAt(footer_start, footer_len);
+}
+
+ThreadPoolCapacityRestorer::ThreadPoolCapacityRestorer()
+    : cpu_threads_(arrow::GetCpuThreadPoolCapacity()), io_threads_(arrow::io::GetIOThreadPoolCapacity()) {}
+
+ThreadPoolCapacityRestorer::~ThreadPoolCapacityRestorer() {
+    arrow::SetCpuThreadPoolCapacity(cpu_threads_).Warn();
+    arrow::io::SetIOThreadPoolCapacity(io_threads_).Warn();
+}
+
+arrow::Status ParseIoFlags(int* argc, char** argv) {
+    std::optional<SimulatedStorageOptions> simulated_storage;
+    int kept = 1;
+    for (int i = 1; i < *argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        try {
+            if (ParseFlagValue(arg, "io", &value)) {
+                ARROW_ASSIGN_OR_RAISE(auto backend, ParseIoBackend(value));
+                SetDefaultIoBackend(backend);
+            } else if (ParseFlagValue(arg, "latency-ms", &value)) {
+                simulated_storage = simulated_storage.value_or(SimulatedStorageOptions());
+                simulated_storage->latency = std::chrono::microseconds(static_cast<int64_t>(std::stod(value) * 1000));
+            } else if (ParseFlagValue(arg, "bandwidth-mbps", &value)) {
+                simulated_storage = simulated_storage.value_or(SimulatedStorageOptions());
+                simulated_storage->bandwidth_bytes_per_second = static_cast<int64_t>(std::stod(value) * 1024 * 1024);
+            } else if (ParseFlagValue(arg, "max-requests", &value)) {
+                simulated_storage = simulated_storage.value_or(SimulatedStorageOptions());
+                simulated_storage->max_concurrent_requests = std::stoi(value);
+            } else if (arg == "--cold") {
+                SetColdCacheMode(true);
+            } else {
+                argv[kept++] = argv[i];
+            }
+        } catch (const std::logic_error&) {
+            return arrow::Status::Invalid("Invalid value in argument ", arg);
+        }
+    }
+    *argc = kept;
+    if (simulated_storage) {
+        SetDefaultSimulatedStorage(simulated_storage);
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> OpenInputFile(const std::string& filename,
+                                                                         IoBackend backend) {
+    switch (backend) {
+        case IoBackend::PREAD:
+            return arrow::io::ReadableFile::Open(filename, BenchmarkMemoryPool());
+        case IoBackend::MMAP:
+            return arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+        case IoBackend::MEMORY: {
+            ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::ReadableFile::Open(filename, BenchmarkMemoryPool()));
+            ARROW_ASSIGN_OR_RAISE(int64_t size, file->GetSize());
+            ARROW_ASSIGN_OR_RAISE(auto buffer, file->ReadAt(0, size));
+            ARROW_RETURN_NOT_OK(file->Close());
+            return std::make_shared<arrow::io::BufferReader>(std::move(buffer));
+        }
+        case IoBackend::IO_URING:
+#ifdef __linux__
+            return IoUringFile::Open(filename);
+#else
+            return arrow::Status::NotImplemented("io_uring is only available on Linux");
+#endif
+        case IoBackend::DIRECT:
+#ifdef __linux__
+            return DirectFile::Open(filename);
+#else
+            return arrow::Status::NotImplemented("O_DIRECT is only available on Linux");
+#endif
+    }
+    return arrow::Status::Invalid("Unknown I/O backend");
+}
+
+arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> OpenInputFile(const std::string& filename) {
+    ARROW_ASSIGN_OR_RAISE(auto file, OpenInputFile(filename, DefaultIoBackend()));
+    auto simulated_storage = DefaultSimulatedStorage();
+    if (!simulated_storage) {
+        return file;
+    }
+    return SimulatedStorageFile::Make(std::move(file), *simulated_storage);
+}
@@ -0,0 +1,161 @@
+#ifndef BENCHMARK_IO_H
+#define BENCHMARK_IO_H
+
+#include <arrow/io/interfaces.h>
+#include <arrow/result.h>
+#include <arrow/status.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// How the benchmarks open Parquet files for reading.
+enum class IoBackend {
+    // arrow::io::ReadableFile, one pread per request
+    PREAD,
+    // arrow::io::MemoryMappedFile
+    MMAP,
+    // The whole file read up front into an arrow::io::BufferReader, so later
+    // reads cost no I/O at all
+    MEMORY,
+    // io_uring, submitting the ranges of each ReadManyAsync call together
+    IO_URING,
+    // pread on a file opened with O_DIRECT, bypassing the page cache; fails to
+    // open on file systems without O_DIRECT support, such as tmpfs
+    DIRECT,
+};
+
+const char* IoBackendName(IoBackend backend);
+// Accepts the names returned by IoBackendName.
+arrow::Result<IoBackend> ParseIoBackend(const std::string& name);
+
+// The backend OpenInputFile uses when none is given; PREAD unless changed.
+IoBackend DefaultIoBackend();
+void SetDefaultIoBackend(IoBackend backend);
+
+// Round-trip cost of a simulated object store. The defaults add nothing.
+struct SimulatedStorageOptions {
+    // Added to every request before its first byte arrives
+    std::chrono::microseconds latency{0};
+    // Shared by all requests of a file, 0 for unlimited
+    int64_t bandwidth_bytes_per_second = 0;
+    // Further requests wait for one to finish, 0 for unlimited
+    int max_concurrent_requests = 0;
+};
+
+struct IoStats {
+    int64_t requests = 0;
+    int64_t bytes_read = 0;
+};
+
+// Wraps a RandomAccessFile so each read first waits as a request to a remote
+// store would, and counts the requests and bytes that reach it. Requests are
+// served concurrently, up to max_concurrent_requests, with their transfers
+// queued behind each other on the shared bandwidth.
+class SimulatedStorageFile : public arrow::io::RandomAccessFile {
+public:
+    static arrow::Result<std::shared_ptr<SimulatedStorageFile>> Make(std::shared_ptr<arrow::io::RandomAccessFile> file,
+                                                                     const SimulatedStorageOptions& options);
+
+    arrow::Status Close() override;
+    bool closed() const override;
+    arrow::Result<int64_t> Tell() const override;
+    arrow::Status Seek(int64_t position) override;
+    arrow::Result<int64_t> GetSize() override;
+    arrow::Result<int64_t> Read(int64_t nbytes, void* out) override;
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override;
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override;
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override;
+
+    IoStats stats() const;
+    void ResetStats();
+
+private:
+    SimulatedStorageFile(std::shared_ptr<arrow::io::RandomAccessFile> file, const SimulatedStorageOptions& options,
+                         int64_t size)
+        : file_(std::move(file)), options_(options), size_(size) {}
+
+    // Blocks for the simulated latency and transfer time of a request, holding
+    // one of the concurrent request slots until EndRequest.
+    void BeginRequest(int64_t position, int64_t nbytes);
+    void EndRequest();
+
+    std::shared_ptr<arrow::io::RandomAccessFile> file_;
+    SimulatedStorageOptions options_;
+    int64_t size_;
+    int64_t position_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable slot_available_;
+    int active_requests_ = 0;
+    std::chrono::steady_clock::time_point link_free_;
+    IoStats stats_;
+};
+
+// Wraps the files OpenInputFile(filename) returns when set; unset by default.
+std::optional<SimulatedStorageOptions> DefaultSimulatedStorage();
+void SetDefaultSimulatedStorage(std::optional<SimulatedStorageOptions> options);
+
+// Cold cache mode: PrepareTimedRead evicts the file before each timed read, so
+// the read starts from storage, as the first read of a cold partition does.
+// Off unless changed.
+bool ColdCacheMode();
+void SetColdCacheMode(bool cold);
+// "cold" or "warm"
+const char* CacheModeName(bool cold);
+
+// Drops the cached pages of `filename` with posix_fadvise(POSIX_FADV_DONTNEED),
+// writing back dirty pages first, since the kernel only drops clean ones. Pages
+// a live mapping holds stay cached. NotImplemented outside Linux.
+arrow::Status EvictFromPageCache(const std::string& filename);
+// Evicts `filename` in cold cache mode and does nothing otherwise. Benchmarks
+// call it, with timing paused, before every timed read of the file.
+arrow::Status PrepareTimedRead(const std::string& filename);
+
+// Where the serialized FileMetaData of a Parquet file starts and its length,
+// from the trailing [footer length]["PAR1"]. Invalid unless the file ends in
+// the magic and the length fits in the file.
+arrow::Status ReadFooterLocation(arrow::io::RandomAccessFile* file, int64_t* footer_start, uint32_t* footer_len);
+// The serialized FileMetaData of a Parquet file, located and checked as
+// ReadFooterLocation does.
+arrow::Result<std::shared_ptr<arrow::Buffer>> ReadFooterBytes(arrow::io::RandomAccessFile* file);
+
+// Puts back the CPU and I/O thread pool capacities it was constructed with
+// when it goes out of scope, so a sweep that resizes the pools leaves them as
+// it found them even when it throws.
+class ThreadPoolCapacityRestorer {
+public:
+    ThreadPoolCapacityRestorer();
+    ~ThreadPoolCapacityRestorer();
+    ThreadPoolCapacityRestorer(const ThreadPoolCapacityRestorer&) = delete;
+    ThreadPoolCapacityRestorer& operator=(const ThreadPoolCapacityRestorer&) = delete;
+
+    int cpu_threads() const { return cpu_threads_; }
+    int io_threads() const { return io_threads_; }
+
+private:
+    int cpu_threads_;
+    int io_threads_;
+};
+
+// Handles the I/O arguments and removes them from argv, so the remaining
+// arguments can go to benchmark::Initialize:
+//   --io=<backend>          sets the default IoBackend
+//   --latency-ms=<ms>       simulates storage with this per-request latency,
+//   --bandwidth-mbps=<MB/s> bandwidth cap
+//   --max-requests=<n>      and concurrent request limit; any one of them
+//                           enables the simulation
+//   --cold                  turns on cold cache mode
+arrow::Status ParseIoFlags(int* argc, char** argv);
+
+// Opens `filename` with `backend` and no simulated storage.
+arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> OpenInputFile(const std::string& filename,
+                                                                         IoBackend backend);
+// Opens `filename` with the default backend, wrapped in a SimulatedStorageFile
+// if default simulated storage is set.
+arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> OpenInputFile(const std::string& filename);
+
+#endif  // BENCHMARK_IO_H
@@ -0,0 +1,286 @@
+#include "benchmark_memory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+std::mutex benchmark_pool_mutex;
+MemoryPoolBackend benchmark_pool_backend = MemoryPoolBackend::DEFAULT;
+// One per backend, never destroyed, so pointers handed out stay valid after a
+// switch.
+std::unique_ptr<TrackingMemoryPool> benchmark_pools[4];
+
+arrow::Result<arrow::MemoryPool*> GetBackendPool(MemoryPoolBackend backend) {
+    arrow::MemoryPool* pool = nullptr;
+    switch (backend) {
+        case MemoryPoolBackend::DEFAULT:
+            return arrow::default_memory_pool();
+        case MemoryPoolBackend::SYSTEM:
+            return arrow::system_memory_pool();
+        case MemoryPoolBackend::JEMALLOC:
+            ARROW_RETURN_NOT_OK(arrow::jemalloc_memory_pool(&pool));
+            return pool;
+        case MemoryPoolBackend::MIMALLOC:
+            ARROW_RETURN_NOT_OK(arrow::mimalloc_memory_pool(&pool));
+            return pool;
+    }
+    return arrow::Status::Invalid("Unknown memory pool backend");
+}
+
+// Zero-byte allocations point here, as in Arrow's own pools
+alignas(64) uint8_t zero_size_area[1];
+
+void UpdateMax(std::atomic<int64_t>* max, int64_t value) {
+    int64_t current = max->load();
+    while (value > current && !max->compare_exchange_weak(current, value)) {
+    }
+}
+
+}  // namespace
+
+const char* MemoryPoolBackendName(MemoryPoolBackend backend) {
+    switch (backend) {
+        case MemoryPoolBackend::DEFAULT: return "default";
+        case MemoryPoolBackend::SYSTEM: return "system";
+        case MemoryPoolBackend::JEMALLOC: return "jemalloc";
+        case MemoryPoolBackend::MIMALLOC: return "mimalloc";
+    }
+    return "unknown";
+}
+
+arrow::Result<MemoryPoolBackend> ParseMemoryPoolBackend(const std::string& name) {
+    for (auto backend : {MemoryPoolBackend::DEFAULT, MemoryPoolBackend::SYSTEM, MemoryPoolBackend::JEMALLOC,
+                         MemoryPoolBackend::MIMALLOC}) {
+        if (name == MemoryPoolBackendName(backend)) {
+            return backend;
+        }
+    }
+    return arrow::Status::Invalid("Unknown memory pool '", name, "', expected default, system, jemalloc or mimalloc");
+}
+
+arrow::Status TrackingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out) {
+    ARROW_RETURN_NOT_OK(wrapped_->Allocate(size, alignment, out));
+    ++allocations_;
+    ++total_allocations_;
+    bytes_allocated_ += size;
+    total_bytes_allocated_ += size;
+    AddOutstanding(size);
+    return arrow::Status::OK();
+}
+
+arrow::Status TrackingMemoryPool::Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t** ptr) {
+    ARROW_RETURN_NOT_OK(wrapped_->Reallocate(old_size, new_size, alignment, ptr));
+    ++reallocations_;
+    if (new_size > old_size) {
+        bytes_allocated_ += new_size - old_size;
+        total_bytes_allocated_ += new_size - old_size;
+    }
+    AddOutstanding(new_size - old_size);
+    return arrow::Status::OK();
+}
+
+void TrackingMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t alignment) {
+    wrapped_->Free(buffer, size, alignment);
+    ++frees_;
+    AddOutstanding(-size);
+}
+
+void TrackingMemoryPool::AddOutstanding(int64_t delta) {
+    int64_t outstanding = bytes_outstanding_ += delta;
+    UpdateMax(&max_memory_, outstanding);
+    UpdateMax(&peak_bytes_, outstanding);
+}
+
+AllocationStats TrackingMemoryPool::stats() const {
+    AllocationStats stats;
+    stats.allocations = allocations_.load();
+    stats.reallocations = reallocations_.load();
+    stats.frees = frees_.load();
+    stats.bytes_allocated = bytes_allocated_.load();
+    stats.peak_bytes = peak_bytes_.load();
+    return stats;
+}
+
+void TrackingMemoryPool::ResetStats() {
+    allocations_ = 0;
+    reallocations_ = 0;
+    frees_ = 0;
+    bytes_allocated_ = 0;
+    peak_bytes_ = bytes_outstanding_.load();
+}
+
+arrow::Result<std::unique_ptr<ArenaMemoryPool>> ArenaMemoryPool::Make(int64_t capacity, arrow::MemoryPool* fallback) {
+    uint8_t* region = nullptr;
+    ARROW_RETURN_NOT_OK(fallback->Allocate(capacity, &region));
+    return std::unique_ptr<ArenaMemoryPool>(new ArenaMemoryPool(region, capacity, fallback));
+}
+
+ArenaMemoryPool::~ArenaMemoryPool() {
+    fallback_->Free(region_, capacity_);
+}
+
+uint8_t* ArenaMemoryPool::AllocateFromRegion(int64_t size, int64_t alignment) {
+    auto start = reinterpret_cast<uintptr_t>(region_) + offset_;
+    uintptr_t aligned = (start + alignment - 1) / alignment * alignment;
+    auto begin = static_cast<int64_t>(aligned - reinterpret_cast<uintptr_t>(region_));
+    if (begin + size > capacity_) {
+        return nullptr;
+    }
+    offset_ = begin + size;
+    live_blocks_[begin] = offset_;
+    ++arena_allocations_;
+    return reinterpret_cast<uint8_t*>(aligned);
+}
+
+arrow::Status ArenaMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out) {
+    if (size == 0) {
+        *out = zero_size_area;
+        return arrow::Status::OK();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    *out = AllocateFromRegion(size, alignment);
+    if (*out == nullptr) {
+        ARROW_RETURN_NOT_OK(fallback_->Allocate(size, alignment, out));
+        ++fallback_allocations_;
+    }
+    bytes_outstanding_ += size;
+    total_bytes_allocated_ += size;
+    max_memory_ = std::max(max_memory_, bytes_outstanding_);
+    return arrow::Status::OK();
+}
+
+arrow::Status ArenaMemoryPool::Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t** ptr) {
+    if (*ptr == zero_size_area) {
+        return Allocate(new_size, alignment, ptr);
+    }
+    if (new_size == 0) {
+        Free(*ptr, old_size, alignment);
+        *ptr = zero_size_area;
+        return arrow::Status::OK();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t growth = new_size - old_size;
+    if (!InRegion(*ptr)) {
+        ARROW_RETURN_NOT_OK(fallback_->Reallocate(old_size, new_size, alignment, ptr));
+    } else if (*ptr + old_size == region_ + offset_ && (*ptr - region_) + new_size <= capacity_) {
+        // The topmost block resizes in place
+        offset_ += growth;
+        live_blocks_[*ptr - region_] = offset_;
+    } else {
+        uint8_t* moved = AllocateFromRegion(new_size, alignment);
+        if (moved == nullptr) {
+            ARROW_RETURN_NOT_OK(fallback_->Allocate(new_size, alignment, &moved));
+            ++fallback_allocations_;
+        }
+        std::memcpy(moved, *ptr, std::min(old_size, new_size));
+        FreeLocked(*ptr, old_size, alignment);
+        bytes_outstanding_ += old_size;
+        *ptr = moved;
+    }
+    bytes_outstanding_ += growth;
+    total_bytes_allocated_ += std::max<int64_t>(growth, 0);
+    max_memory_ = std::max(max_memory_, bytes_outstanding_);
+    return arrow::Status::OK();
+}
+
+void ArenaMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t alignment) {
+    if (buffer == zero_size_area) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeLocked(buffer, size, alignment);
+}
+
+void ArenaMemoryPool::FreeLocked(uint8_t* buffer, int64_t size, int64_t alignment) {
+    bytes_outstanding_ -= size;
+    if (!InRegion(buffer)) {
+        fallback_->Free(buffer, size, alignment);
+        return;
+    }
+    live_blocks_.erase(buffer - region_);
+    int64_t top = live_blocks_.empty() ? 0 : live_blocks_.rbegin()->second;
+    if (top < offset_) {
+        offset_ = top;
+        ++rewinds_;
+    }
+}
+
+int64_t ArenaMemoryPool::bytes_allocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_outstanding_;
+}
+
+int64_t ArenaMemoryPool::max_memory() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_memory_;
+}
+
+int64_t ArenaMemoryPool::total_bytes_allocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_bytes_allocated_;
+}
+
+int64_t ArenaMemoryPool::num_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_allocations_ + fallback_allocations_;
+}
+
+int64_t ArenaMemoryPool::arena_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_allocations_;
+}
+
+int64_t ArenaMemoryPool::fallback_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fallback_allocations_;
+}
+
+int64_t ArenaMemoryPool::rewinds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rewinds_;
+}
+
+TrackingMemoryPool* BenchmarkMemoryPool() {
+    std::lock_guard<std::mutex> lock(benchmark_pool_mutex);
+    auto& pool = benchmark_pools[static_cast<int>(benchmark_pool_backend)];
+    if (!pool) {
+        pool = std::make_unique<TrackingMemoryPool>(arrow::default_memory_pool());
+    }
+    return pool.get();
+}
+
+MemoryPoolBackend BenchmarkMemoryPoolBackend() {
+    std::lock_guard<std::mutex> lock(benchmark_pool_mutex);
+    return benchmark_pool_backend;
+}
+
+arrow::Status SetBenchmarkMemoryPool(MemoryPoolBackend backend) {
+    ARROW_ASSIGN_OR_RAISE(arrow::MemoryPool* pool, GetBackendPool(backend));
+    std::lock_guard<std::mutex> lock(benchmark_pool_mutex);
+    const auto& current = benchmark_pools[static_cast<int>(benchmark_pool_backend)];
+    if (current && current->bytes_allocated() > 0) {
+        return arrow::Status::Invalid("Cannot change the memory pool while it holds memory");
+    }
+    auto& selected = benchmark_pools[static_cast<int>(backend)];
+    if (!selected) {
+        selected = std::make_unique<TrackingMemoryPool>(pool);
+    }
+    benchmark_pool_backend = backend;
+    return arrow::Status::OK();
+}
+
+arrow::Status ParseMemoryPoolFlags(int* argc, char** argv) {
+    const std::string prefix = "--pool=";
+    int kept = 1;
+    for (int i = 1; i < *argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) {
+            ARROW_ASSIGN_OR_RAISE(auto backend, ParseMemoryPoolBackend(arg.substr(prefix.size())));
+            ARROW_RETURN_NOT_OK(SetBenchmarkMemoryPool(backend));
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    *argc = kept;
+    return arrow::Status::OK();
+}
@@ -0,0 +1,153 @@
+#ifndef BENCHMARK_MEMORY_H
+#define BENCHMARK_MEMORY_H
+
+#include <arrow/memory_pool.h>
+#include <arrow/result.h>
+#include <arrow/status.h>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// The allocator behind the benchmarks' memory pool.
+enum class MemoryPoolBackend {
+    // arrow::default_memory_pool(), which Arrow picks at build time or from
+    // the ARROW_DEFAULT_MEMORY_POOL environment variable
+    DEFAULT,
+    SYSTEM,
+    JEMALLOC,
+    MIMALLOC,
+};
+
+const char* MemoryPoolBackendName(MemoryPoolBackend backend);
+// Accepts the names returned by MemoryPoolBackendName.
+arrow::Result<MemoryPoolBackend> ParseMemoryPoolBackend(const std::string& name);
+
+// Allocation activity of a TrackingMemoryPool since its last ResetStats.
+struct AllocationStats {
+    int64_t allocations = 0;
+    int64_t reallocations = 0;
+    int64_t frees = 0;
+    // Bytes requested by allocations, plus the growth of reallocations
+    int64_t bytes_allocated = 0;
+    // Most bytes outstanding at once, counting those allocated before the reset
+    int64_t peak_bytes = 0;
+};
+
+// Forwards to another pool and counts what passes through. The counters are
+// atomics, so concurrent readers can share one pool, but they are not read as
+// one snapshot.
+class TrackingMemoryPool : public arrow::MemoryPool {
+public:
+    explicit TrackingMemoryPool(arrow::MemoryPool* wrapped) : wrapped_(wrapped) {}
+
+    using arrow::MemoryPool::Allocate;
+    using arrow::MemoryPool::Free;
+    using arrow::MemoryPool::Reallocate;
+
+    arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+    arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t** ptr) override;
+    void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+    void ReleaseUnused() override { wrapped_->ReleaseUnused(); }
+
+    int64_t bytes_allocated() const override { return bytes_outstanding_.load(); }
+    int64_t max_memory() const override { return max_memory_.load(); }
+    int64_t total_bytes_allocated() const override { return total_bytes_allocated_.load(); }
+    int64_t num_allocations() const override { return total_allocations_.load(); }
+    std::string backend_name() const override { return wrapped_->backend_name(); }
+
+    AllocationStats stats() const;
+    // Starts a new phase: zeroes the counters and restarts the peak from the
+    // bytes outstanding now.
+    void ResetStats();
+
+private:
+    void AddOutstanding(int64_t delta);
+
+    arrow::MemoryPool* wrapped_;
+    std::atomic<int64_t> bytes_outstanding_{0};
+    std::atomic<int64_t> max_memory_{0};
+    std::atomic<int64_t> total_bytes_allocated_{0};
+    std::atomic<int64_t> total_allocations_{0};
+
+    std::atomic<int64_t> allocations_{0};
+    std::atomic<int64_t> reallocations_{0};
+    std::atomic<int64_t> frees_{0};
+    std::atomic<int64_t> bytes_allocated_{0};
+    std::atomic<int64_t> peak_bytes_{0};
+};
+
+// Bump allocator over one region allocated up front, for decode scratch
+// memory such as the page and decompression buffers that die with their column
+// chunk. Freeing the topmost live block rewinds the bump pointer to the end of
+// the highest block still live, so once a chunk's buffers are gone the next
+// chunk, and the next row group, reuses the same memory; long-lived blocks
+// further down, such as the footer, do not stop that. Requests that do not fit
+// go to the fallback pool. Memory that outlives a row group, such as the
+// decoded Arrow arrays, belongs in the reader's Arrow pool rather than here.
+class ArenaMemoryPool : public arrow::MemoryPool {
+public:
+    static arrow::Result<std::unique_ptr<ArenaMemoryPool>> Make(int64_t capacity, arrow::MemoryPool* fallback);
+    ~ArenaMemoryPool() override;
+
+    using arrow::MemoryPool::Allocate;
+    using arrow::MemoryPool::Free;
+    using arrow::MemoryPool::Reallocate;
+
+    arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+    arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t** ptr) override;
+    void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+
+    int64_t bytes_allocated() const override;
+    int64_t max_memory() const override;
+    int64_t total_bytes_allocated() const override;
+    int64_t num_allocations() const override;
+    std::string backend_name() const override { return "arena"; }
+
+    int64_t capacity() const { return capacity_; }
+    // Allocations served from the region and from the fallback pool
+    int64_t arena_allocations() const;
+    int64_t fallback_allocations() const;
+    // Times a free moved the bump pointer back
+    int64_t rewinds() const;
+
+private:
+    ArenaMemoryPool(uint8_t* region, int64_t capacity, arrow::MemoryPool* fallback)
+        : region_(region), capacity_(capacity), fallback_(fallback) {}
+
+    bool InRegion(const uint8_t* p) const { return p >= region_ && p < region_ + capacity_; }
+    // Returns nullptr if the region is full; called with mutex_ held.
+    uint8_t* AllocateFromRegion(int64_t size, int64_t alignment);
+    void FreeLocked(uint8_t* buffer, int64_t size, int64_t alignment);
+
+    uint8_t* region_;
+    int64_t capacity_;
+    arrow::MemoryPool* fallback_;
+
+    mutable std::mutex mutex_;
+    int64_t offset_ = 0;
+    // Start to end offset of the blocks live in the region
+    std::map<int64_t, int64_t> live_blocks_;
+    int64_t bytes_outstanding_ = 0;
+    int64_t max_memory_ = 0;
+    int64_t total_bytes_allocated_ = 0;
+    int64_t arena_allocations_ = 0;
+    int64_t fallback_allocations_ = 0;
+    int64_t rewinds_ = 0;
+};
+
+// The pool benchmarks allocate from in place of arrow::default_memory_pool():
+// a TrackingMemoryPool over the backend set with SetBenchmarkMemoryPool.
+TrackingMemoryPool* BenchmarkMemoryPool();
+MemoryPoolBackend BenchmarkMemoryPoolBackend();
+// Fails with NotImplemented if Arrow was built without the backend, and with
+// Invalid once BenchmarkMemoryPool() holds memory.
+arrow::Status SetBenchmarkMemoryPool(MemoryPoolBackend backend);
+
+// Handles --pool=<backend> and removes it from argv, as ParseIoFlags does for
+// the I/O arguments.
+arrow::Status ParseMemoryPoolFlags(int* argc, char** argv);
+
+#endif  // BENCHMARK_MEMORY_H
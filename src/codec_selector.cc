@@ -0,0 +1,138 @@
+#include "codec_selector.h"
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+
+constexpr int kDecompressRuns = 3;
+
+// The raw values of the column's first `sample_rows` rows, or null if the
+// column is not fixed-width.
+std::shared_ptr<arrow::Buffer> SampleBytes(const arrow::ChunkedArray& column, int64_t sample_rows) {
+    if (column.num_chunks() == 0) {
+        return nullptr;
+    }
+    const auto& chunk = column.chunk(0);
+    const auto* type = dynamic_cast<const arrow::FixedWidthType*>(chunk->type().get());
+    if (type == nullptr || type->bit_width() % 8 != 0 || chunk->data()->buffers.size() < 2 ||
+        chunk->data()->buffers[1] == nullptr) {
+        return nullptr;
+    }
+    int64_t width = type->bit_width() / 8;
+    int64_t rows = std::min(sample_rows, chunk->length());
+    return arrow::SliceBuffer(chunk->data()->buffers[1], chunk->offset() * width, rows * width);
+}
+
+arrow::Result<CodecSample> MeasureSample(const arrow::Buffer& sample, const CodecChoice& choice) {
+    CodecSample result;
+    result.choice = choice;
+    if (choice.codec == parquet::Compression::UNCOMPRESSED) {
+        result.compressed_bytes = sample.size();
+        return result;
+    }
+    ARROW_ASSIGN_OR_RAISE(auto codec, arrow::util::Codec::Create(choice.codec, choice.level));
+    int64_t max_length = codec->MaxCompressedLen(sample.size(), sample.data());
+    std::vector<uint8_t> compressed(max_length);
+    ARROW_ASSIGN_OR_RAISE(result.compressed_bytes,
+                          codec->Compress(sample.size(), sample.data(), max_length, compressed.data()));
+
+    std::vector<uint8_t> decompressed(sample.size());
+    for (int i = 0; i < kDecompressRuns; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        ARROW_RETURN_NOT_OK(codec->Decompress(result.compressed_bytes, compressed.data(), sample.size(),
+                                              decompressed.data()));
+        auto end = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration<double, std::micro>(end - start).count();
+        result.decompress_time_us = i == 0 ? time : std::min(result.decompress_time_us, time);
+    }
+    return result;
+}
+
+}  // namespace
+
+std::string CodecChoiceName(const CodecChoice& choice) {
+    std::string name = arrow::util::Codec::GetCodecAsString(choice.codec);
+    if (choice.level != arrow::util::kUseDefaultCompressionLevel) {
+        name += "(" + std::to_string(choice.level) + ")";
+    }
+    return name;
+}
+
+void SetCompression(parquet::WriterProperties::Builder* builder, const CodecChoice& choice) {
+    builder->compression(choice.codec);
+    if (choice.level != arrow::util::kUseDefaultCompressionLevel) {
+        builder->compression_level(choice.level);
+    }
+}
+
+void SetColumnCompression(parquet::WriterProperties::Builder* builder, const std::string& column,
+                          const CodecChoice& choice) {
+    builder->compression(column, choice.codec);
+    if (choice.level != arrow::util::kUseDefaultCompressionLevel) {
+        builder->compression_level(column, choice.level);
+    }
+}
+
+const char* CodecGoalName(CodecGoal goal) {
+    switch (goal) {
+        case CodecGoal::SIZE: return "size";
+        case CodecGoal::DECODE_SPEED: return "decode_speed";
+        case CodecGoal::WEIGHTED: return "weighted";
+    }
+    return "unknown";
+}
+
+size_t BestCodecSample(const std::vector<CodecSample>& samples, CodecGoal goal, double size_weight) {
+    int64_t max_bytes = 1;
+    double max_time = std::numeric_limits<double>::min();
+    for (const auto& sample : samples) {
+        max_bytes = std::max(max_bytes, sample.compressed_bytes);
+        max_time = std::max(max_time, sample.decompress_time_us);
+    }
+    auto cost = [&](const CodecSample& sample) {
+        double size = static_cast<double>(sample.compressed_bytes) / max_bytes;
+        double time = sample.decompress_time_us / max_time;
+        switch (goal) {
+            case CodecGoal::SIZE:
+                return std::make_pair(size, time);
+            case CodecGoal::DECODE_SPEED:
+                return std::make_pair(time, size);
+            case CodecGoal::WEIGHTED:
+                break;
+        }
+        return std::make_pair(size_weight * size + (1 - size_weight) * time, size);
+    };
+
+    size_t best = 0;
+    for (size_t i = 1; i < samples.size(); ++i) {
+        if (cost(samples[i]) < cost(samples[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+arrow::Result<CodecSelection> SelectColumnCodecs(const arrow::Table& table, const std::vector<CodecChoice>& candidates,
+                                                 CodecGoal goal, int64_t sample_rows, double size_weight) {
+    if (candidates.empty()) {
+        return arrow::Status::Invalid("No candidate codecs");
+    }
+    CodecSelection selection;
+    for (int c = 0; c < table.num_columns(); ++c) {
+        auto sample = SampleBytes(*table.column(c), sample_rows);
+        std::vector<CodecSample> samples;
+        if (sample != nullptr) {
+            for (const auto& candidate : candidates) {
+                ARROW_ASSIGN_OR_RAISE(auto result, MeasureSample(*sample, candidate));
+                samples.push_back(result);
+            }
+        }
+        selection.choices.push_back(samples.empty() ? candidates[0]
+                                                    : candidates[BestCodecSample(samples, goal, size_weight)]);
+        selection.samples.push_back(std::move(samples));
+    }
+    return selection;
+}
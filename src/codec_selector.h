@@ -0,0 +1,61 @@
+#ifndef CODEC_SELECTOR_H
+#define CODEC_SELECTOR_H
+
+#include <arrow/result.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+#include <parquet/properties.h>
+#include <string>
+#include <vector>
+
+// A codec and its level; kUseDefaultCompressionLevel leaves the level to the
+// codec, and is the only level codecs without levels accept.
+struct CodecChoice {
+    parquet::Compression::type codec = parquet::Compression::UNCOMPRESSED;
+    int level = arrow::util::kUseDefaultCompressionLevel;
+};
+
+// "zstd" or "zstd(3)"
+std::string CodecChoiceName(const CodecChoice& choice);
+void SetCompression(parquet::WriterProperties::Builder* builder, const CodecChoice& choice);
+void SetColumnCompression(parquet::WriterProperties::Builder* builder, const std::string& column,
+                          const CodecChoice& choice);
+
+// What SelectColumnCodecs minimizes.
+enum class CodecGoal {
+    SIZE,
+    // Decompression time, ties broken by size
+    DECODE_SPEED,
+    // size_weight * size + (1 - size_weight) * decompression time, each
+    // relative to the largest and slowest candidate for the column
+    WEIGHTED,
+};
+
+const char* CodecGoalName(CodecGoal goal);
+
+// One candidate's result on one column's sample.
+struct CodecSample {
+    CodecChoice choice;
+    int64_t compressed_bytes = 0;
+    double decompress_time_us = 0;
+};
+
+struct CodecSelection {
+    std::vector<CodecChoice> choices;
+    // Per column, the sample results of every candidate, in candidate order
+    std::vector<std::vector<CodecSample>> samples;
+};
+
+// Picks one of `candidates` for every column of `table`. Each candidate
+// compresses the column's first `sample_rows` values, taken as their raw Arrow
+// buffer, which is the PLAIN encoding of fixed-width columns; columns of other
+// types get the first candidate. Decompression is timed as the best of a few
+// runs.
+arrow::Result<CodecSelection> SelectColumnCodecs(const arrow::Table& table, const std::vector<CodecChoice>& candidates,
+                                                 CodecGoal goal, int64_t sample_rows = 10000,
+                                                 double size_weight = 0.5);
+
+// Index of the best of `samples` for `goal`, as SelectColumnCodecs decides.
+size_t BestCodecSample(const std::vector<CodecSample>& samples, CodecGoal goal, double size_weight = 0.5);
+
+#endif  // CODEC_SELECTOR_H
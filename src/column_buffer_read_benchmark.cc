@@ -0,0 +1,126 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "column_buffer_reader.h"
+#include "data_generator.h"
+#include <arrow/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/properties.h>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <iostream>
+
+// Column reads of a DataGenerator float32 file through FileReader::ReadColumn,
+// which builds a new Arrow array per column, against ReadColumnChunk decoding
+// each column chunk into one reused ColumnReadBuffer. Both readers, page and
+// decompression buffers included, allocate from a ProxyMemoryPool, whose
+// allocations are reported per row group along with the ColumnReadBuffer's own.
+
+namespace {
+
+constexpr char kFilename[] = "column_buffer_read_benchmark.parquet";
+constexpr int kNumColumns = 100;
+// DataGenerator writes 10000-row row groups, so 20 of them
+constexpr int kNumRows = 200000;
+
+void GenerateFile() {
+    if (std::ifstream(kFilename)) {
+        std::cout << "File " << kFilename << " already exists. Skipping..." << std::endl;
+        return;
+    }
+    PARQUET_THROW_NOT_OK(DataGenerator::WriteParquetFile(kNumColumns, kNumRows, kFilename));
+    std::cout << "Generated file: " << kFilename << std::endl;
+}
+
+void SetCounters(benchmark::State& state, int num_row_groups, int64_t num_columns, int64_t pool_allocations,
+                 int64_t buffer_allocations) {
+    double row_group_reads = static_cast<double>(state.iterations()) * num_row_groups;
+    state.SetBytesProcessed(state.iterations() * kNumRows * num_columns * static_cast<int64_t>(sizeof(float)));
+    state.counters["PoolAllocsPerRowGroup"] = pool_allocations / row_group_reads;
+    state.counters["BufferAllocs"] = buffer_allocations;
+}
+
+// range(0): number of columns read, starting from the first.
+void BM_ArrowReadColumn(benchmark::State& state) {
+    int num_columns = state.range(0);
+    arrow::ProxyMemoryPool pool(BenchmarkMemoryPool());
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(kFilename));
+    parquet::arrow::FileReaderBuilder builder;
+    PARQUET_THROW_NOT_OK(builder.Open(file, parquet::ReaderProperties(&pool)));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(builder.memory_pool(&pool)->Build(&reader));
+    int num_row_groups = reader->num_row_groups();
+
+    int64_t allocations_before = pool.num_allocations();
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(kFilename));
+        state.ResumeTiming();
+        for (int c = 0; c < num_columns; ++c) {
+            std::shared_ptr<arrow::ChunkedArray> column;
+            PARQUET_THROW_NOT_OK(reader->ReadColumn(c, &column));
+            benchmark::DoNotOptimize(column);
+        }
+    }
+    SetCounters(state, num_row_groups, num_columns, pool.num_allocations() - allocations_before, 0);
+}
+BENCHMARK(BM_ArrowReadColumn)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+// Same columns, row group by row group, into a single ColumnReadBuffer.
+void BM_ColumnBufferRead(benchmark::State& state) {
+    int num_columns = state.range(0);
+    arrow::ProxyMemoryPool pool(BenchmarkMemoryPool());
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(kFilename));
+    auto reader = parquet::ParquetFileReader::Open(file, parquet::ReaderProperties(&pool));
+    int num_row_groups = reader->metadata()->num_row_groups();
+
+    ColumnReadBuffer<float> buffer;
+    int64_t allocations_before = pool.num_allocations();
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(kFilename));
+        state.ResumeTiming();
+        for (int rg = 0; rg < num_row_groups; ++rg) {
+            auto row_group = reader->RowGroup(rg);
+            for (int c = 0; c < num_columns; ++c) {
+                ReadColumnChunk(*row_group, c, &buffer);
+                benchmark::DoNotOptimize(buffer.values());
+            }
+        }
+    }
+    SetCounters(state, num_row_groups, num_columns, pool.num_allocations() - allocations_before,
+                buffer.num_allocations());
+}
+BENCHMARK(BM_ColumnBufferRead)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    try {
+        GenerateFile();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in GenerateFile: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "column_buffer_reader.h"
+#include <parquet/column_reader.h>
+#include <parquet/exception.h>
+#include <new>
+
+namespace {
+
+template <typename T>
+struct ParquetTypeFor;
+template <>
+struct ParquetTypeFor<int32_t> { using type = parquet::Int32Type; };
+template <>
+struct ParquetTypeFor<int64_t> { using type = parquet::Int64Type; };
+template <>
+struct ParquetTypeFor<float> { using type = parquet::FloatType; };
+template <>
+struct ParquetTypeFor<double> { using type = parquet::DoubleType; };
+
+template <typename T>
+T* AllocateAligned(int64_t n, size_t alignment) {
+    // aligned_alloc wants a multiple of the alignment
+    size_t size = (n * sizeof(T) + alignment - 1) / alignment * alignment;
+    void* p = std::aligned_alloc(alignment, size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+}
+
+}  // namespace
+
+template <typename T>
+void ColumnReadBuffer<T>::Reserve(int64_t n) {
+    if (n <= capacity_) {
+        return;
+    }
+    values_.reset(AllocateAligned<T>(n, kAlignment));
+    def_levels_.reset(AllocateAligned<int16_t>(n, kAlignment));
+    capacity_ = n;
+    num_allocations_ += 2;
+}
+
+template <typename T>
+void ReadColumnChunk(parquet::RowGroupReader& row_group, int column, ColumnReadBuffer<T>* buffer) {
+    using DType = typename ParquetTypeFor<T>::type;
+    auto reader = row_group.Column(column);
+    if (reader->type() != DType::type_num) {
+        throw parquet::ParquetException("Column ", column, " is not of the requested physical type");
+    }
+    if (reader->descr()->max_repetition_level() > 0) {
+        throw parquet::ParquetException("Column ", column, " is repeated");
+    }
+    auto* typed_reader = static_cast<parquet::TypedColumnReader<DType>*>(reader.get());
+
+    int64_t num_levels = row_group.metadata()->ColumnChunk(column)->num_values();
+    buffer->Reserve(num_levels);
+    buffer->num_levels = 0;
+    buffer->num_values = 0;
+    while (typed_reader->HasNext()) {
+        int64_t values_read = 0;
+        int64_t levels_read = typed_reader->ReadBatch(num_levels - buffer->num_levels,
+                                                      buffer->def_levels() + buffer->num_levels, nullptr,
+                                                      buffer->values() + buffer->num_values, &values_read);
+        if (levels_read == 0) {
+            break;
+        }
+        buffer->num_levels += levels_read;
+        buffer->num_values += values_read;
+    }
+    if (buffer->num_levels != num_levels) {
+        throw parquet::ParquetException("Column ", column, " ended after ", buffer->num_levels, " of ", num_levels,
+                                        " values");
+    }
+}
+
+#define INSTANTIATE_COLUMN_BUFFER_READER(T)  \
+    template class ColumnReadBuffer<T>;     \
+    template void ReadColumnChunk<T>(parquet::RowGroupReader&, int, ColumnReadBuffer<T>*);
+
+INSTANTIATE_COLUMN_BUFFER_READER(int32_t)
+INSTANTIATE_COLUMN_BUFFER_READER(int64_t)
+INSTANTIATE_COLUMN_BUFFER_READER(float)
+INSTANTIATE_COLUMN_BUFFER_READER(double)
@@ -0,0 +1,51 @@
+#ifndef COLUMN_BUFFER_READER_H
+#define COLUMN_BUFFER_READER_H
+
+#include <parquet/file_reader.h>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+// Caller-owned decode target for whole column chunks: 64-byte aligned values
+// and definition levels. The arrays grow to the largest chunk read and are then
+// reused, so reading chunks no larger than that allocates nothing here.
+template <typename T>
+class ColumnReadBuffer {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    // Makes room for `n` levels and values, discarding the contents if it has to grow.
+    void Reserve(int64_t n);
+
+    T* values() { return values_.get(); }
+    const T* values() const { return values_.get(); }
+    int16_t* def_levels() { return def_levels_.get(); }
+    const int16_t* def_levels() const { return def_levels_.get(); }
+    int64_t capacity() const { return capacity_; }
+    // Times Reserve had to allocate
+    int64_t num_allocations() const { return num_allocations_; }
+
+    // Set by ReadColumnChunk. Values are packed: nulls have a level below the
+    // column's max definition level and no entry in values().
+    int64_t num_levels = 0;
+    int64_t num_values = 0;
+
+private:
+    struct AlignedFree {
+        void operator()(void* p) const { std::free(p); }
+    };
+
+    std::unique_ptr<T[], AlignedFree> values_;
+    std::unique_ptr<int16_t[], AlignedFree> def_levels_;
+    int64_t capacity_ = 0;
+    int64_t num_allocations_ = 0;
+};
+
+// Decodes all of `column` in `row_group` into `buffer` with
+// parquet::TypedColumnReader::ReadBatch, for flat INT32 (int32_t), INT64
+// (int64_t), FLOAT (float) and DOUBLE (double) columns; T must match the
+// column's physical type. Throws parquet::ParquetException otherwise.
+template <typename T>
+void ReadColumnChunk(parquet::RowGroupReader& row_group, int column, ColumnReadBuffer<T>* buffer);
+
+#endif  // COLUMN_BUFFER_READER_H
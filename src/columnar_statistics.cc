@@ -0,0 +1,148 @@
+#include "columnar_statistics.h"
+#include <parquet/exception.h>
+#include <parquet/statistics.h>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+template <typename T>
+struct ParquetTypeFor;
+template <>
+struct ParquetTypeFor<int32_t> { using type = parquet::Int32Type; };
+template <>
+struct ParquetTypeFor<int64_t> { using type = parquet::Int64Type; };
+template <>
+struct ParquetTypeFor<float> { using type = parquet::FloatType; };
+template <>
+struct ParquetTypeFor<double> { using type = parquet::DoubleType; };
+
+// Reads one bound from min8/max8, whose low sizeof(T) bytes hold the plain
+// encoding, or from the min_value/max_value bytes.
+template <typename T>
+bool LoadBound(const flatbuffers::Vector<int8_t>* value, flatbuffers::Optional<int64_t> value8, T* out) {
+    if (value8.has_value()) {
+        int64_t bits = *value8;
+        std::memcpy(out, &bits, sizeof(T));
+        return true;
+    }
+    if (value == nullptr) {
+        return false;
+    }
+    if (value->size() != sizeof(T)) {
+        throw parquet::ParquetException("Statistics value of ", value->size(), " bytes, expected ", sizeof(T));
+    }
+    std::memcpy(out, value->data(), sizeof(T));
+    return true;
+}
+
+template <typename T>
+void DecodeChunk(const parquet2::ColumnChunk& chunk, StatisticsArrays<T>* out, size_t i) {
+    const auto* metadata = chunk.meta_data();
+    const auto* statistics = metadata ? metadata->statistics() : nullptr;
+    if (statistics == nullptr) {
+        return;
+    }
+    if (statistics->null_count().has_value()) {
+        out->null_count[i] = statistics->null_count().value();
+    }
+    T min;
+    T max;
+    if (LoadBound(statistics->min_value(), statistics->min8(), &min) &&
+        LoadBound(statistics->max_value(), statistics->max8(), &max)) {
+        out->min[i] = min;
+        out->max[i] = max;
+        out->has_min_max[i] = 1;
+    }
+}
+
+template <typename T>
+void DecodeChunk(const parquet::ColumnChunkMetaData& chunk, StatisticsArrays<T>* out, size_t i) {
+    if (!chunk.is_stats_set()) {
+        return;
+    }
+    auto statistics = chunk.statistics();
+    if (!statistics) {
+        return;
+    }
+    if (statistics->HasNullCount()) {
+        out->null_count[i] = statistics->null_count();
+    }
+    if (statistics->HasMinMax()) {
+        const auto& typed =
+            static_cast<const parquet::TypedStatistics<typename ParquetTypeFor<T>::type>&>(*statistics);
+        out->min[i] = typed.min();
+        out->max[i] = typed.max();
+        out->has_min_max[i] = 1;
+    }
+}
+
+}  // namespace
+
+template <typename T>
+void StatisticsArrays<T>::Resize(size_t n) {
+    min.assign(n, std::numeric_limits<T>::lowest());
+    max.assign(n, std::numeric_limits<T>::max());
+    null_count.assign(n, 0);
+    has_min_max.assign(n, 0);
+}
+
+template <typename T>
+void DecodeColumnStatistics(const parquet2::FileMetaData& metadata, int column, StatisticsArrays<T>* out) {
+    const auto* row_groups = metadata.row_groups();
+    out->Resize(row_groups ? row_groups->size() : 0);
+    for (size_t rg = 0; rg < out->size(); ++rg) {
+        DecodeChunk(*row_groups->Get(rg)->columns()->Get(column), out, rg);
+    }
+}
+
+template <typename T>
+void DecodeRowGroupStatistics(const parquet2::FileMetaData& metadata, int row_group, StatisticsArrays<T>* out) {
+    const auto* columns = metadata.row_groups()->Get(row_group)->columns();
+    out->Resize(columns->size());
+    for (size_t c = 0; c < out->size(); ++c) {
+        DecodeChunk(*columns->Get(c), out, c);
+    }
+}
+
+template <typename T>
+void DecodeColumnStatistics(const parquet::FileMetaData& metadata, int column, StatisticsArrays<T>* out) {
+    out->Resize(metadata.num_row_groups());
+    for (int rg = 0; rg < metadata.num_row_groups(); ++rg) {
+        DecodeChunk(*metadata.RowGroup(rg)->ColumnChunk(column), out, rg);
+    }
+}
+
+template <typename T>
+void DecodeRowGroupStatistics(const parquet::FileMetaData& metadata, int row_group, StatisticsArrays<T>* out) {
+    auto metadata_row_group = metadata.RowGroup(row_group);
+    out->Resize(metadata_row_group->num_columns());
+    for (int c = 0; c < metadata_row_group->num_columns(); ++c) {
+        DecodeChunk(*metadata_row_group->ColumnChunk(c), out, c);
+    }
+}
+
+template <typename T>
+void MayMatchRange(const StatisticsArrays<T>& statistics, T lo, T hi, std::vector<uint8_t>* may_match) {
+    size_t n = statistics.size();
+    may_match->resize(n);
+    const T* min = statistics.min.data();
+    const T* max = statistics.max.data();
+    uint8_t* result = may_match->data();
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = (max[i] >= lo) & (min[i] < hi);
+    }
+}
+
+#define INSTANTIATE_COLUMNAR_STATISTICS(T)                                                                          \
+    template struct StatisticsArrays<T>;                                                                            \
+    template void DecodeColumnStatistics<T>(const parquet2::FileMetaData&, int, StatisticsArrays<T>*);              \
+    template void DecodeRowGroupStatistics<T>(const parquet2::FileMetaData&, int, StatisticsArrays<T>*);            \
+    template void DecodeColumnStatistics<T>(const parquet::FileMetaData&, int, StatisticsArrays<T>*);               \
+    template void DecodeRowGroupStatistics<T>(const parquet::FileMetaData&, int, StatisticsArrays<T>*);             \
+    template void MayMatchRange<T>(const StatisticsArrays<T>&, T, T, std::vector<uint8_t>*);
+
+INSTANTIATE_COLUMNAR_STATISTICS(int32_t)
+INSTANTIATE_COLUMNAR_STATISTICS(int64_t)
+INSTANTIATE_COLUMNAR_STATISTICS(float)
+INSTANTIATE_COLUMNAR_STATISTICS(double)
@@ -0,0 +1,47 @@
+#ifndef COLUMNAR_STATISTICS_H
+#define COLUMNAR_STATISTICS_H
+
+#include <parquet/metadata.h>
+#include <cstdint>
+#include <vector>
+#include "flatbuff_ns_generated.h"
+
+// Chunk statistics of a set of column chunks, one entry per chunk in contiguous
+// typed arrays. Chunks without min/max get the widest possible range, so range
+// checks over the arrays never prune them.
+template <typename T>
+struct StatisticsArrays {
+    std::vector<T> min;
+    std::vector<T> max;
+    std::vector<int64_t> null_count;
+    std::vector<uint8_t> has_min_max;
+
+    size_t size() const { return min.size(); }
+    void Resize(size_t n);
+};
+
+// Decoders for the plain-encoded INT32 (int32_t), INT64 (int64_t), FLOAT (float)
+// and DOUBLE (double) columns; T must match the column's physical type. They
+// throw parquet::ParquetException if a min/max has the wrong width.
+//
+// The parquet2 FlatBuffer versions read the inline min8/max8 form written by
+// FooterCodecOptions::optimize_statistics when present, and min_value/max_value
+// otherwise. Neither allocates per chunk.
+template <typename T>
+void DecodeColumnStatistics(const parquet2::FileMetaData& metadata, int column, StatisticsArrays<T>* out);
+template <typename T>
+void DecodeRowGroupStatistics(const parquet2::FileMetaData& metadata, int row_group, StatisticsArrays<T>* out);
+
+// The same through Arrow's metadata objects, one ColumnChunkMetaData and
+// Statistics per chunk.
+template <typename T>
+void DecodeColumnStatistics(const parquet::FileMetaData& metadata, int column, StatisticsArrays<T>* out);
+template <typename T>
+void DecodeRowGroupStatistics(const parquet::FileMetaData& metadata, int row_group, StatisticsArrays<T>* out);
+
+// Sets (*may_match)[i] to whether chunk i may hold values in [lo, hi). The loop
+// has no branches, so compilers vectorize it.
+template <typename T>
+void MayMatchRange(const StatisticsArrays<T>& statistics, T lo, T hi, std::vector<uint8_t>* may_match);
+
+#endif  // COLUMNAR_STATISTICS_H
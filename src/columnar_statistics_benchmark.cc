@@ -0,0 +1,221 @@
+#include "benchmark_flags.h"
+#include "benchmark_memory.h"
+#include "columnar_statistics.h"
+#include "footer_codec.h"
+#include <parquet/exception.h>
+#include <parquet/metadata.h>
+#include <parquet/properties.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+// Statistics of many column chunks decoded one Statistics object at a time
+// through parquet::FileMetaData, against StatisticsArrays filled straight from
+// the FlatBuffer footer, with min_value/max_value or with the inline min8/max8.
+// Each iteration decodes either one column across all row groups or one row
+// group across all columns, then evaluates a range predicate over the result.
+//
+// The metadata is synthetic: FLOAT columns whose chunk ranges grow with the row
+// group index. The 10000 columns x 1000 row groups case holds ten million chunks
+// and needs several GB of memory for the Thrift and FlatBuffer footers; the
+// FlatBuffer modes are skipped for a layout that exceeds FlatBuffers' 2 GiB
+// limit.
+
+namespace {
+
+constexpr int64_t kRowsPerRowGroup = 1000;
+// FlatBuffers addresses its buffer with signed 32-bit offsets
+constexpr int64_t kMaxFlatbufferSize = std::numeric_limits<int32_t>::max();
+
+const char* kModeNames[] = {"PerObject", "FlatbufValue", "FlatbufMin8"};
+
+struct SyntheticFooter {
+    int num_columns = 0;
+    int num_row_groups = 0;
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    // Empty when the layout exceeds kMaxFlatbufferSize; the sizes are estimates
+    std::string flatbuffer_values;
+    std::string flatbuffer_min8;
+    int64_t flatbuffer_values_size = 0;
+    int64_t flatbuffer_min8_size = 0;
+};
+
+std::string EncodeFloat(float value) {
+    std::string result(sizeof(value), '\0');
+    std::memcpy(&result[0], &value, sizeof(value));
+    return result;
+}
+
+std::shared_ptr<parquet::FileMetaData> MakeMetadata(int num_columns, int num_row_groups) {
+    parquet::schema::NodeVector fields;
+    for (int c = 0; c < num_columns; ++c) {
+        fields.push_back(parquet::schema::PrimitiveNode::Make("col_" + std::to_string(c),
+                                                              parquet::Repetition::REQUIRED,
+                                                              parquet::Type::FLOAT));
+    }
+    parquet::SchemaDescriptor schema;
+    schema.Init(parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
+
+    auto builder = parquet::FileMetaDataBuilder::Make(&schema, parquet::default_writer_properties());
+    int64_t chunk_size = kRowsPerRowGroup * sizeof(float);
+    int64_t offset = 4;
+    for (int rg = 0; rg < num_row_groups; ++rg) {
+        auto* row_group_builder = builder->AppendRowGroup();
+        row_group_builder->set_num_rows(kRowsPerRowGroup);
+        for (int c = 0; c < num_columns; ++c) {
+            parquet::EncodedStatistics statistics;
+            statistics.set_min(EncodeFloat(static_cast<float>(rg * kRowsPerRowGroup + c % 100)));
+            statistics.set_max(EncodeFloat(static_cast<float>((rg + 1) * kRowsPerRowGroup - 1)));
+            statistics.set_null_count(0);
+            auto* chunk_builder = row_group_builder->NextColumnChunk();
+            chunk_builder->SetStatistics(statistics);
+            chunk_builder->Finish(kRowsPerRowGroup, 0, 0, offset, chunk_size, chunk_size, false, false, {},
+                                  {{parquet::Encoding::PLAIN, 1}});
+            offset += chunk_size;
+        }
+        row_group_builder->Finish(chunk_size * num_columns);
+    }
+    return builder->Finish();
+}
+
+// The FlatBuffer layout used by a mode, or an empty string if it does not fit
+// FlatBuffers' 2 GiB limit. Every row group has the same statistics sizes, so
+// the footer size is measured on a one-row-group footer and scaled.
+std::string ConvertIfFits(const parquet::FileMetaData& metadata, const parquet::FileMetaData& one_row_group,
+                          const FooterCodecOptions& options, int64_t* estimated_size) {
+    *estimated_size = static_cast<int64_t>(ConvertToFlatbuffer(one_row_group, options).size()) *
+                      metadata.num_row_groups();
+    if (*estimated_size > kMaxFlatbufferSize) {
+        return "";
+    }
+    return ConvertToFlatbuffer(metadata, options);
+}
+
+// Only the footer of the running benchmark is kept; the largest ones do not fit twice.
+const SyntheticFooter& GetFooter(int num_columns, int num_row_groups) {
+    static SyntheticFooter footer;
+    if (footer.num_columns != num_columns || footer.num_row_groups != num_row_groups) {
+        footer = SyntheticFooter();
+        footer.metadata = MakeMetadata(num_columns, num_row_groups);
+        auto one_row_group = MakeMetadata(num_columns, 1);
+        footer.flatbuffer_values = ConvertIfFits(*footer.metadata, *one_row_group, FooterCodecOptions::None(),
+                                                 &footer.flatbuffer_values_size);
+        FooterCodecOptions min8;
+        min8.optimize_statistics = true;
+        footer.flatbuffer_min8 = ConvertIfFits(*footer.metadata, *one_row_group, min8, &footer.flatbuffer_min8_size);
+        footer.num_columns = num_columns;
+        footer.num_row_groups = num_row_groups;
+    }
+    return footer;
+}
+
+// The FlatBuffer of a FlatBuffer mode, or nullptr after skipping the benchmark
+// if it does not fit.
+const parquet2::FileMetaData* GetFlatbuffer(benchmark::State& state, const SyntheticFooter& footer, int64_t mode) {
+    const auto& flatbuffer = mode == 1 ? footer.flatbuffer_values : footer.flatbuffer_min8;
+    if (flatbuffer.empty()) {
+        int64_t size = mode == 1 ? footer.flatbuffer_values_size : footer.flatbuffer_min8_size;
+        state.SkipWithError(("FlatBuffer footer of about " + std::to_string(size >> 20) +
+                             " MB exceeds the 2 GiB limit").c_str());
+        return nullptr;
+    }
+    return parquet2::GetFileMetaData(flatbuffer.data());
+}
+
+template <typename Decode>
+void RunStatisticsBenchmark(benchmark::State& state, int64_t num_chunks, float lo, float hi, Decode decode) {
+    StatisticsArrays<float> statistics;
+    std::vector<uint8_t> may_match;
+    int64_t matches = 0;
+    for (auto _ : state) {
+        decode(&statistics);
+        MayMatchRange(statistics, lo, hi, &may_match);
+        matches = 0;
+        for (uint8_t match : may_match) {
+            matches += match;
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetLabel(kModeNames[state.range(2)]);
+    state.SetItemsProcessed(state.iterations() * num_chunks);
+    state.counters["ChunksMatched"] = matches;
+}
+
+// range(0): columns, range(1): row groups, range(2): mode (see kModeNames).
+// Decodes the middle column across every row group.
+void BM_ColumnStatisticsAcrossRowGroups(benchmark::State& state) {
+    const auto& footer = GetFooter(state.range(0), state.range(1));
+    int column = footer.num_columns / 2;
+    // About a tenth of the row groups overlap the range
+    float lo = static_cast<float>(footer.num_row_groups * kRowsPerRowGroup * 0.45);
+    float hi = static_cast<float>(footer.num_row_groups * kRowsPerRowGroup * 0.55);
+    int64_t mode = state.range(2);
+    const parquet2::FileMetaData* flatbuffer = mode == 0 ? nullptr : GetFlatbuffer(state, footer, mode);
+    if (mode != 0 && flatbuffer == nullptr) {
+        return;
+    }
+    RunStatisticsBenchmark(state, footer.num_row_groups, lo, hi, [&](StatisticsArrays<float>* statistics) {
+        if (mode == 0) {
+            DecodeColumnStatistics(*footer.metadata, column, statistics);
+        } else {
+            DecodeColumnStatistics(*flatbuffer, column, statistics);
+        }
+    });
+}
+
+// Decodes every column of the middle row group.
+void BM_RowGroupStatisticsAcrossColumns(benchmark::State& state) {
+    const auto& footer = GetFooter(state.range(0), state.range(1));
+    int row_group = footer.num_row_groups / 2;
+    float lo = static_cast<float>(row_group * kRowsPerRowGroup + 45);
+    float hi = static_cast<float>(row_group * kRowsPerRowGroup + 55);
+    int64_t mode = state.range(2);
+    const parquet2::FileMetaData* flatbuffer = mode == 0 ? nullptr : GetFlatbuffer(state, footer, mode);
+    if (mode != 0 && flatbuffer == nullptr) {
+        return;
+    }
+    RunStatisticsBenchmark(state, footer.num_columns, lo, hi, [&](StatisticsArrays<float>* statistics) {
+        if (mode == 0) {
+            DecodeRowGroupStatistics(*footer.metadata, row_group, statistics);
+        } else {
+            DecodeRowGroupStatistics(*flatbuffer, row_group, statistics);
+        }
+    });
+}
+
+// Shape-major order, so each benchmark builds every synthetic footer once.
+void StatisticsArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t columns : {1000, 10000}) {
+        for (int64_t row_groups : {10, 100, 1000}) {
+            for (int64_t mode = 0; mode < 3; ++mode) {
+                b->Args({columns, row_groups, mode});
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_ColumnStatisticsAcrossRowGroups)->Apply(StatisticsArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RowGroupStatisticsAcrossColumns)->Apply(StatisticsArgs)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -1,114 +1,488 @@
 #include "compression_benchmark.h"
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "synthetic_data.h"
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
 #include <arrow/io/file.h>
-#include <random>
+#include <arrow/io/memory.h>
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
 
+namespace {
+
+// Random float32 in [-1000, 1000], as DataGenerator writes, or int64 columns
+// that increase by small random steps, as timestamps and ids do
+arrow::Result<std::shared_ptr<arrow::Table>> MakeTable(parquet::Type::type data_type, int num_columns, int num_rows,
+                                                       arrow::MemoryPool* pool) {
+    ColumnSpec spec;
+    if (data_type == parquet::Type::INT64) {
+        spec.type = arrow::int64();
+        spec.distribution = ValueDistribution::INCREASING;
+        spec.low = 1700000000000;
+        spec.high = 1000;
+    }
+    return GenerateTable(num_columns, num_rows, pool, spec);
+}
+
+// Alternating float32 and int64 columns of MakeTable, so the columns differ in
+// what compresses them best
+arrow::Result<std::shared_ptr<arrow::Table>> MakeMixedTable(int num_columns, int num_rows, arrow::MemoryPool* pool) {
+    ARROW_ASSIGN_OR_RAISE(auto floats, MakeTable(parquet::Type::FLOAT, (num_columns + 1) / 2, num_rows, pool));
+    ARROW_ASSIGN_OR_RAISE(auto ints, MakeTable(parquet::Type::INT64, num_columns / 2, num_rows, pool));
+
+    std::vector<std::shared_ptr<arrow::Field>> schema_vector;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    for (int i = 0; i < num_columns; ++i) {
+        const auto& source = i % 2 == 0 ? floats : ints;
+        auto column = source->column(i / 2);
+        schema_vector.push_back(arrow::field("col_" + std::to_string(i), column->type()));
+        columns.push_back(column);
+    }
+    return arrow::Table::Make(arrow::schema(schema_vector), columns);
+}
+
+struct WriteMeasurement {
+    double encoding_time_ms;
+    double decoding_time_ms;
+    double compressed_size_mb;
+};
+
+arrow::Result<WriteMeasurement> MeasureWriteAndRead(const arrow::Table& table,
+                                                    std::shared_ptr<parquet::WriterProperties> properties,
+                                                    const std::string& filename) {
+    arrow::MemoryPool* pool = BenchmarkMemoryPool();
+    WriteMeasurement result;
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(table, pool, outfile, 10000, properties));
+    auto end = std::chrono::high_resolution_clock::now();
+    result.encoding_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    ARROW_RETURN_NOT_OK(outfile->Close());
+
+    // Get file size
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    ARROW_ASSIGN_OR_RAISE(infile, OpenInputFile(filename));
+    result.compressed_size_mb = static_cast<double>(infile->GetSize().ValueOrDie()) / (1024 * 1024);
+
+    // Read and measure decoding time
+    start = std::chrono::high_resolution_clock::now();
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    ARROW_RETURN_NOT_OK(parquet::arrow::OpenFile(infile, pool, &reader));
+    std::shared_ptr<arrow::Table> read_table;
+    ARROW_RETURN_NOT_OK(reader->ReadTable(&read_table));
+    end = std::chrono::high_resolution_clock::now();
+    result.decoding_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Clean up the temporary file
+    std::remove(filename.c_str());
+    return result;
+}
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double MbPerSecond(double size_mb, double time_ms) {
+    return time_ms > 0 ? size_mb / (time_ms / 1000) : 0;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WriteToBuffer(const arrow::Table& table,
+                                                            std::shared_ptr<parquet::WriterProperties> properties,
+                                                            double* time_ms) {
+    ARROW_ASSIGN_OR_RAISE(auto sink, arrow::io::BufferOutputStream::Create(1024 * 1024, BenchmarkMemoryPool()));
+    auto start = std::chrono::high_resolution_clock::now();
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(table, BenchmarkMemoryPool(), sink, 10000, properties));
+    *time_ms = ElapsedMs(start);
+    return sink->Finish();
+}
+
+// Times ReadTable only; opening the reader parses the footer first.
+arrow::Status ReadFromBuffer(const std::shared_ptr<arrow::Buffer>& buffer, double* time_ms) {
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    ARROW_RETURN_NOT_OK(parquet::arrow::OpenFile(std::make_shared<arrow::io::BufferReader>(buffer),
+                                                 BenchmarkMemoryPool(), &reader));
+    auto start = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<arrow::Table> table;
+    ARROW_RETURN_NOT_OK(reader->ReadTable(&table));
+    *time_ms = ElapsedMs(start);
+    return arrow::Status::OK();
+}
+
+// The column chunks of an uncompressed file, page headers included, which are
+// a few bytes per page against the writer compressing page bodies alone.
+arrow::Result<std::vector<std::shared_ptr<arrow::Buffer>>> ColumnChunks(const std::shared_ptr<arrow::Buffer>& file) {
+    auto metadata = parquet::ReadMetaData(std::make_shared<arrow::io::BufferReader>(file));
+    std::vector<std::shared_ptr<arrow::Buffer>> chunks;
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        auto row_group = metadata->RowGroup(rg);
+        for (int c = 0; c < row_group->num_columns(); ++c) {
+            auto column = row_group->ColumnChunk(c);
+            int64_t offset = column->has_dictionary_page() ? column->dictionary_page_offset()
+                                                           : column->data_page_offset();
+            ARROW_ASSIGN_OR_RAISE(auto chunk, arrow::SliceBufferSafe(file, offset, column->total_compressed_size()));
+            chunks.push_back(std::move(chunk));
+        }
+    }
+    return chunks;
+}
+
+// Compresses and decompresses every chunk with the codec, as the writer and
+// reader do page by page.
+arrow::Status MeasureCodec(const std::vector<std::shared_ptr<arrow::Buffer>>& chunks, const CodecChoice& choice,
+                           double* compress_ms, double* decompress_ms) {
+    *compress_ms = 0;
+    *decompress_ms = 0;
+    if (choice.codec == parquet::Compression::UNCOMPRESSED) {
+        return arrow::Status::OK();
+    }
+    ARROW_ASSIGN_OR_RAISE(auto codec, arrow::util::Codec::Create(choice.codec, choice.level));
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> decompressed;
+    for (const auto& chunk : chunks) {
+        compressed.resize(codec->MaxCompressedLen(chunk->size(), chunk->data()));
+        decompressed.resize(chunk->size());
+
+        auto start = std::chrono::high_resolution_clock::now();
+        ARROW_ASSIGN_OR_RAISE(int64_t compressed_size, codec->Compress(chunk->size(), chunk->data(),
+                                                                       compressed.size(), compressed.data()));
+        *compress_ms += ElapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        ARROW_RETURN_NOT_OK(codec->Decompress(compressed_size, compressed.data(), decompressed.size(),
+                                              decompressed.data()));
+        *decompress_ms += ElapsedMs(start);
+    }
+    return arrow::Status::OK();
+}
+
+}  // namespace
+
+parquet::Compression::type ToParquetCompression(CompressionAlgorithm algorithm) {
+    switch (algorithm) {
+        case CompressionAlgorithm::UNCOMPRESSED: return parquet::Compression::UNCOMPRESSED;
+        case CompressionAlgorithm::SNAPPY: return parquet::Compression::SNAPPY;
+        case CompressionAlgorithm::GZIP: return parquet::Compression::GZIP;
+        case CompressionAlgorithm::BROTLI: return parquet::Compression::BROTLI;
+        case CompressionAlgorithm::ZSTD: return parquet::Compression::ZSTD;
+        // Written as LZ4_RAW
+        case CompressionAlgorithm::LZ4: return parquet::Compression::LZ4;
+    }
+    return parquet::Compression::UNCOMPRESSED;
+}
+
+std::string CompressionAlgorithmName(CompressionAlgorithm algorithm) {
+    return arrow::util::Codec::GetCodecAsString(ToParquetCompression(algorithm));
+}
+
+std::vector<std::pair<CompressionAlgorithm, int>> CompressionBenchmark::CodecMatrix() {
+    std::vector<std::pair<CompressionAlgorithm, int>> matrix;
+    for (auto algo : {CompressionAlgorithm::UNCOMPRESSED, CompressionAlgorithm::SNAPPY, CompressionAlgorithm::GZIP,
+                      CompressionAlgorithm::BROTLI, CompressionAlgorithm::ZSTD, CompressionAlgorithm::LZ4}) {
+        matrix.emplace_back(algo, arrow::util::kUseDefaultCompressionLevel);
+        if (algo != CompressionAlgorithm::ZSTD && algo != CompressionAlgorithm::LZ4) {
+            continue;
+        }
+        auto max_level = arrow::util::Codec::MaximumCompressionLevel(ToParquetCompression(algo));
+        for (int level = 1; level <= std::min(19, max_level.ValueOr(0)); ++level) {
+            matrix.emplace_back(algo, level);
+        }
+    }
+    return matrix;
+}
+
 arrow::Status CompressionBenchmark::RunBenchmark(int num_columns, int num_rows, const std::string& filename_prefix) {
     std::vector<CompressionBenchmarkResult> results;
-    std::vector<CompressionAlgorithm> algorithms = {
-        CompressionAlgorithm::UNCOMPRESSED,
-        CompressionAlgorithm::SNAPPY,
-        CompressionAlgorithm::GZIP,
-        CompressionAlgorithm::BROTLI,
-        CompressionAlgorithm::ZSTD
+    std::vector<ColumnEncoding> encodings = {
+        ColumnEncoding::PLAIN,
+        ColumnEncoding::DICTIONARY,
+        ColumnEncoding::BYTE_STREAM_SPLIT,
+        ColumnEncoding::DELTA_BINARY_PACKED
     };
+    for (auto data_type : {parquet::Type::FLOAT, parquet::Type::INT64}) {
+        // Generate data
+        ARROW_ASSIGN_OR_RAISE(auto table, MakeTable(data_type, num_columns, num_rows, BenchmarkMemoryPool()));
 
-    for (auto algo : algorithms) {
-        CompressionBenchmarkResult result;
-        result.algorithm = algo;
-        result.num_columns = num_columns;
-        result.num_rows = num_rows;
+        for (auto encoding : encodings) {
+            if (!SupportsEncoding(data_type, encoding)) {
+                continue;
+            }
+            for (const auto& [algo, level] : CodecMatrix()) {
+                CompressionBenchmarkResult result;
+                result.algorithm = algo;
+                result.compression_level = level;
+                result.num_columns = num_columns;
+                result.num_rows = num_rows;
+                result.data_type = data_type;
+                result.encoding = encoding;
 
-        // Generate data
-        arrow::MemoryPool* pool = arrow::default_memory_pool();
-        std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-        std::vector<std::shared_ptr<arrow::Array>> arrays;
+                // Write with compression
+                std::string filename = filename_prefix + "_" + std::to_string(static_cast<int>(algo)) + ".parquet";
+                parquet::WriterProperties::Builder builder;
+                SetCompression(&builder, {ToParquetCompression(algo), level});
+                SetColumnEncoding(&builder, encoding);
 
-        for (int i = 0; i < num_columns; ++i) {
-            schema_vector.push_back(arrow::field("col_" + std::to_string(i), arrow::float32()));
+                ARROW_ASSIGN_OR_RAISE(auto measurement, MeasureWriteAndRead(*table, builder.build(), filename));
+                result.encoding_time_ms = measurement.encoding_time_ms;
+                result.decoding_time_ms = measurement.decoding_time_ms;
+                result.compressed_size_mb = measurement.compressed_size_mb;
+                results.push_back(result);
+            }
+        }
+    }
 
-            arrow::FloatBuilder builder(pool);
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+    WriteBenchmarkResults(results, filename_prefix + "_compression_benchmark.csv");
+    return arrow::Status::OK();
+}
 
-            for (int j = 0; j < num_rows; ++j) {
-                ARROW_RETURN_NOT_OK(builder.Append(dis(gen)));
+arrow::Status CompressionBenchmark::RunInMemoryBenchmark(int num_columns, int num_rows,
+                                                         const std::string& filename_prefix) {
+    std::vector<InMemoryBenchmarkResult> results;
+    for (auto data_type : {parquet::Type::FLOAT, parquet::Type::INT64}) {
+        ARROW_ASSIGN_OR_RAISE(auto table, MakeTable(data_type, num_columns, num_rows, BenchmarkMemoryPool()));
+        double uncompressed_mb = static_cast<double>(num_columns) * num_rows * parquet::GetTypeByteSize(data_type) /
+                                 (1024 * 1024);
+
+        for (auto encoding : {ColumnEncoding::PLAIN, ColumnEncoding::DICTIONARY, ColumnEncoding::BYTE_STREAM_SPLIT,
+                              ColumnEncoding::DELTA_BINARY_PACKED}) {
+            if (!SupportsEncoding(data_type, encoding)) {
+                continue;
             }
+            // Encoding and decoding do not depend on the codec
+            parquet::WriterProperties::Builder encode_builder;
+            SetColumnEncoding(&encode_builder, encoding);
+            double encode_ms = 0;
+            double decode_ms = 0;
+            ARROW_ASSIGN_OR_RAISE(auto encoded, WriteToBuffer(*table, encode_builder.build(), &encode_ms));
+            ARROW_RETURN_NOT_OK(ReadFromBuffer(encoded, &decode_ms));
+            ARROW_ASSIGN_OR_RAISE(auto chunks, ColumnChunks(encoded));
+
+            for (const auto& [algo, level] : CodecMatrix()) {
+                InMemoryBenchmarkResult result;
+                result.algorithm = algo;
+                result.compression_level = level;
+                result.num_columns = num_columns;
+                result.num_rows = num_rows;
+                result.data_type = data_type;
+                result.encoding = encoding;
+                result.uncompressed_size_mb = uncompressed_mb;
+                result.encoded_size_mb = static_cast<double>(encoded->size()) / (1024 * 1024);
+                result.encode_mb_per_s = MbPerSecond(uncompressed_mb, encode_ms);
+                result.decode_mb_per_s = MbPerSecond(uncompressed_mb, decode_ms);
+
+                CodecChoice choice{ToParquetCompression(algo), level};
+                double compress_ms = 0;
+                double decompress_ms = 0;
+                ARROW_RETURN_NOT_OK(MeasureCodec(chunks, choice, &compress_ms, &decompress_ms));
+                result.compress_mb_per_s = MbPerSecond(uncompressed_mb, compress_ms);
+                result.decompress_mb_per_s = MbPerSecond(uncompressed_mb, decompress_ms);
 
-            std::shared_ptr<arrow::Array> array;
-            ARROW_RETURN_NOT_OK(builder.Finish(&array));
-            arrays.push_back(array);
+                parquet::WriterProperties::Builder builder;
+                SetCompression(&builder, choice);
+                SetColumnEncoding(&builder, encoding);
+                double write_ms = 0;
+                double read_ms = 0;
+                ARROW_ASSIGN_OR_RAISE(auto compressed, WriteToBuffer(*table, builder.build(), &write_ms));
+                ARROW_RETURN_NOT_OK(ReadFromBuffer(compressed, &read_ms));
+                result.compressed_size_mb = static_cast<double>(compressed->size()) / (1024 * 1024);
+                result.write_mb_per_s = MbPerSecond(uncompressed_mb, write_ms);
+                result.read_mb_per_s = MbPerSecond(uncompressed_mb, read_ms);
+                results.push_back(result);
+            }
         }
+    }
+
+    WriteInMemoryResults(results, filename_prefix + "_in_memory_benchmark.csv");
+    return arrow::Status::OK();
+}
 
-        auto schema = std::make_shared<arrow::Schema>(schema_vector);
-        auto table = arrow::Table::Make(schema, arrays);
+void CompressionBenchmark::WriteInMemoryResults(const std::vector<InMemoryBenchmarkResult>& results,
+                                                const std::string& filename) {
+    std::ofstream file(filename);
+    file << "algorithm,compression_level,num_columns,num_rows,data_type,encoding,uncompressed_size_mb,"
+         << "encoded_size_mb,compressed_size_mb,encode_mb_per_s,compress_mb_per_s,decompress_mb_per_s,"
+         << "decode_mb_per_s,write_mb_per_s,read_mb_per_s,memory_pool\n";
+    for (const auto& result : results) {
+        file << CompressionAlgorithmName(result.algorithm) << ",";
+        if (result.compression_level != arrow::util::kUseDefaultCompressionLevel) {
+            file << result.compression_level;
+        }
+        file << "," << result.num_columns << ","
+             << result.num_rows << ","
+             << parquet::TypeToString(result.data_type) << ","
+             << ColumnEncodingName(result.encoding) << ","
+             << result.uncompressed_size_mb << ","
+             << result.encoded_size_mb << ","
+             << result.compressed_size_mb << ","
+             << result.encode_mb_per_s << ","
+             << result.compress_mb_per_s << ","
+             << result.decompress_mb_per_s << ","
+             << result.decode_mb_per_s << ","
+             << result.write_mb_per_s << ","
+             << result.read_mb_per_s << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
 
-        // Write with compression
-        std::string filename = filename_prefix + "_" + std::to_string(static_cast<int>(algo)) + ".parquet";
-        std::shared_ptr<arrow::io::FileOutputStream> outfile;
-        ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+arrow::Status CompressionBenchmark::RunAdaptiveCodecBenchmark(int num_columns, int num_rows,
+                                                              const std::string& filename_prefix) {
+    const std::vector<CodecChoice> candidates = {
+        {parquet::Compression::SNAPPY},
+        {parquet::Compression::LZ4},
+        {parquet::Compression::ZSTD, 1},
+        {parquet::Compression::ZSTD, 3},
+        {parquet::Compression::ZSTD, 9},
+        {parquet::Compression::ZSTD, 19},
+        {parquet::Compression::GZIP},
+    };
+    std::string filename = filename_prefix + "_adaptive.parquet";
+    ARROW_ASSIGN_OR_RAISE(auto table, MakeMixedTable(num_columns, num_rows, BenchmarkMemoryPool()));
 
+    // Every candidate as the one codec of the file; the results stand in for
+    // samples, so the best global codec is picked by the same rule as the
+    // per-column ones
+    std::vector<CodecSample> global_samples;
+    std::vector<WriteMeasurement> global_measurements;
+    for (const auto& candidate : candidates) {
         parquet::WriterProperties::Builder builder;
-        builder.compression(static_cast<parquet::Compression::type>(algo));
+        SetCompression(&builder, candidate);
+        SetColumnEncoding(&builder, ColumnEncoding::PLAIN);
+        ARROW_ASSIGN_OR_RAISE(auto measurement, MeasureWriteAndRead(*table, builder.build(), filename));
 
-        auto start = std::chrono::high_resolution_clock::now();
-        ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, pool, outfile, 10000, builder.build()));
-        auto end = std::chrono::high_resolution_clock::now();
-        result.encoding_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        CodecSample sample;
+        sample.choice = candidate;
+        sample.compressed_bytes = static_cast<int64_t>(measurement.compressed_size_mb * 1024 * 1024);
+        sample.decompress_time_us = measurement.decoding_time_ms * 1000;
+        global_samples.push_back(sample);
+        global_measurements.push_back(measurement);
+    }
 
-        ARROW_RETURN_NOT_OK(outfile->Close());
+    std::vector<AdaptiveCodecResult> results;
+    for (auto goal : {CodecGoal::SIZE, CodecGoal::DECODE_SPEED, CodecGoal::WEIGHTED}) {
+        AdaptiveCodecResult result;
+        result.num_columns = num_columns;
+        result.num_rows = num_rows;
+        result.goal = goal;
 
-        // Get file size
-        std::shared_ptr<arrow::io::ReadableFile> infile;
-        ARROW_ASSIGN_OR_RAISE(infile, arrow::io::ReadableFile::Open(filename));
-        result.compressed_size_mb = static_cast<double>(infile->GetSize().ValueOrDie()) / (1024 * 1024);
+        size_t best = BestCodecSample(global_samples, goal);
+        result.best_global_codec = candidates[best];
+        result.best_global_size_mb = global_measurements[best].compressed_size_mb;
+        result.best_global_decoding_time_ms = global_measurements[best].decoding_time_ms;
 
-        // Read and measure decoding time
-        start = std::chrono::high_resolution_clock::now();
-        std::unique_ptr<parquet::arrow::FileReader> reader;
-        ARROW_RETURN_NOT_OK(parquet::arrow::OpenFile(infile, pool, &reader));
-        std::shared_ptr<arrow::Table> read_table;
-        ARROW_RETURN_NOT_OK(reader->ReadTable(&read_table));
-        end = std::chrono::high_resolution_clock::now();
-        result.decoding_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        auto start = std::chrono::high_resolution_clock::now();
+        ARROW_ASSIGN_OR_RAISE(auto selection, SelectColumnCodecs(*table, candidates, goal));
+        auto end = std::chrono::high_resolution_clock::now();
+        result.selection_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
 
+        parquet::WriterProperties::Builder builder;
+        SetColumnEncoding(&builder, ColumnEncoding::PLAIN);
+        for (int i = 0; i < table->num_columns(); ++i) {
+            SetColumnCompression(&builder, table->field(i)->name(), selection.choices[i]);
+            ++result.codec_mix[CodecChoiceName(selection.choices[i])];
+        }
+        ARROW_ASSIGN_OR_RAISE(auto measurement, MeasureWriteAndRead(*table, builder.build(), filename));
+        result.adaptive_size_mb = measurement.compressed_size_mb;
+        result.adaptive_encoding_time_ms = measurement.encoding_time_ms;
+        result.adaptive_decoding_time_ms = measurement.decoding_time_ms;
         results.push_back(result);
-
-        // Clean up the temporary file
-        std::remove(filename.c_str());
     }
 
-    WriteBenchmarkResults(results, filename_prefix + "_compression_benchmark.csv");
+    WriteAdaptiveCodecResults(results, filename_prefix + "_adaptive_codec.csv");
     return arrow::Status::OK();
 }
 
+void CompressionBenchmark::WriteAdaptiveCodecResults(const std::vector<AdaptiveCodecResult>& results,
+                                                     const std::string& filename) {
+    std::ofstream file(filename);
+    file << "goal,num_columns,num_rows,best_global_codec,best_global_size_mb,best_global_decoding_time_ms,"
+         << "adaptive_size_mb,adaptive_encoding_time_ms,adaptive_decoding_time_ms,selection_time_ms,"
+         << "size_gain_percent,decoding_gain_percent,codec_mix,memory_pool\n";
+    for (const auto& result : results) {
+        // The codec mix as "snappy:3;zstd(9):7", one field of the CSV
+        std::string codec_mix;
+        for (const auto& [name, count] : result.codec_mix) {
+            codec_mix += (codec_mix.empty() ? "" : ";") + name + ":" + std::to_string(count);
+        }
+        file << CodecGoalName(result.goal) << ","
+             << result.num_columns << ","
+             << result.num_rows << ","
+             << CodecChoiceName(result.best_global_codec) << ","
+             << result.best_global_size_mb << ","
+             << result.best_global_decoding_time_ms << ","
+             << result.adaptive_size_mb << ","
+             << result.adaptive_encoding_time_ms << ","
+             << result.adaptive_decoding_time_ms << ","
+             << result.selection_time_ms << ","
+             << 100 * (1 - result.adaptive_size_mb / result.best_global_size_mb) << ","
+             << 100 * (1 - result.adaptive_decoding_time_ms / result.best_global_decoding_time_ms) << ","
+             << codec_mix << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
+
 void CompressionBenchmark::WriteBenchmarkResults(const std::vector<CompressionBenchmarkResult>& results, const std::string& filename) {
     std::ofstream file(filename);
-    file << "algorithm,num_columns,num_rows,encoding_time_ms,decoding_time_ms,compressed_size_mb\n";
+    file << "algorithm,num_columns,num_rows,encoding_time_ms,decoding_time_ms,compressed_size_mb,memory_pool,"
+         << "data_type,encoding,compression_level\n";
     for (const auto& result : results) {
-        file << static_cast<int>(result.algorithm) << ","
+        file << CompressionAlgorithmName(result.algorithm) << ","
              << result.num_columns << ","
              << result.num_rows << ","
              << result.encoding_time_ms << ","
              << result.decoding_time_ms << ","
-             << result.compressed_size_mb << "\n";
+             << result.compressed_size_mb << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << ","
+             << parquet::TypeToString(result.data_type) << ","
+             << ColumnEncodingName(result.encoding) << ",";
+        if (result.compression_level != arrow::util::kUseDefaultCompressionLevel) {
+            file << result.compression_level;
+        }
+        file << "\n";
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    // --adaptive-codecs compares per-column codec selection with the best
+    // global codec instead of running the codec matrix, and --in-memory runs
+    // the matrix without files
+    bool adaptive_codecs = false;
+    bool in_memory = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--adaptive-codecs") {
+            adaptive_codecs = true;
+        } else if (std::string(argv[i]) == "--in-memory") {
+            in_memory = true;
+        }
+    }
     std::vector<int> column_counts = {10, 100, 1000};
     int num_rows = 10000;  
     std::string filename_prefix = "compression_benchmark";
 
     for (int num_columns : column_counts) {
         std::cout << "Running benchmark for " << num_columns << " columns..." << std::endl;
-        auto status = CompressionBenchmark::RunBenchmark(num_columns, num_rows, 
-                                                         filename_prefix + "_" + std::to_string(num_columns));
+        std::string prefix = filename_prefix + "_" + std::to_string(num_columns);
+        arrow::Status status;
+        if (adaptive_codecs) {
+            status = CompressionBenchmark::RunAdaptiveCodecBenchmark(num_columns, num_rows, prefix);
+        } else if (in_memory) {
+            status = CompressionBenchmark::RunInMemoryBenchmark(num_columns, num_rows, prefix);
+        } else {
+            status = CompressionBenchmark::RunBenchmark(num_columns, num_rows, prefix);
+        }
         if (!status.ok()) {
             std::cerr << "Error running benchmark for " << num_columns << " columns: " 
                       << status.ToString() << std::endl;
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "codec_selector.h"
+#include "data_generator.h"
 #include <arrow/api.h>
+#include <parquet/types.h>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -9,9 +13,14 @@ enum class CompressionAlgorithm {
     SNAPPY,
     GZIP,
     BROTLI,
-    ZSTD
+    ZSTD,
+    LZ4
 };
 
+parquet::Compression::type ToParquetCompression(CompressionAlgorithm algorithm);
+// The codec's Arrow name, such as "zstd" or "lz4_raw", as the CSVs write it
+std::string CompressionAlgorithmName(CompressionAlgorithm algorithm);
+
 struct CompressionBenchmarkResult {
     CompressionAlgorithm algorithm;
     int num_columns;
@@ -19,10 +28,76 @@ struct CompressionBenchmarkResult {
     double encoding_time_ms;
     double decoding_time_ms;
     double compressed_size_mb;
+    parquet::Type::type data_type;
+    ColumnEncoding encoding;
+    // arrow::util::kUseDefaultCompressionLevel for the codec's default
+    int compression_level;
+};
+
+// Per-column codecs from SelectColumnCodecs against the best single codec,
+// both judged by the same goal on the written file.
+struct AdaptiveCodecResult {
+    int num_columns;
+    int num_rows;
+    CodecGoal goal;
+    CodecChoice best_global_codec;
+    double best_global_size_mb;
+    double best_global_decoding_time_ms;
+    double adaptive_size_mb;
+    double adaptive_encoding_time_ms;
+    double adaptive_decoding_time_ms;
+    double selection_time_ms;
+    // Codec name to number of columns given it
+    std::map<std::string, int> codec_mix;
+};
+
+// One codec and encoding written to and read back from memory, with each
+// stage timed on its own. Throughputs are in MB/s of the uncompressed Arrow
+// values, whatever the stage's input.
+struct InMemoryBenchmarkResult {
+    CompressionAlgorithm algorithm;
+    int compression_level;
+    int num_columns;
+    int num_rows;
+    parquet::Type::type data_type;
+    ColumnEncoding encoding;
+    double uncompressed_size_mb;
+    // The file written without compression, and with the codec
+    double encoded_size_mb;
+    double compressed_size_mb;
+    // WriteTable without compression, and ReadTable of that file once its
+    // footer is parsed
+    double encode_mb_per_s;
+    double decode_mb_per_s;
+    // The codec alone on the encoded column chunks; 0 for UNCOMPRESSED
+    double compress_mb_per_s;
+    double decompress_mb_per_s;
+    // WriteTable and ReadTable with the codec, every stage together
+    double write_mb_per_s;
+    double read_mb_per_s;
 };
 
 class CompressionBenchmark {
 public:
+    // Writes every codec at every level of the matrix with every encoding the
+    // column type supports, for random float32 columns and for increasing int64
+    // columns.
     static arrow::Status RunBenchmark(int num_columns, int num_rows, const std::string& filename_prefix);
     static void WriteBenchmarkResults(const std::vector<CompressionBenchmarkResult>& results, const std::string& filename);
-};
\ No newline at end of file
+    // The codecs and levels RunBenchmark writes: every codec at its default
+    // level, and LZ4 and ZSTD at levels 1 to 19 as far as each goes.
+    static std::vector<std::pair<CompressionAlgorithm, int>> CodecMatrix();
+
+    // For a table of alternating float32 and int64 columns written PLAIN, and
+    // for each CodecGoal, compares per-column codec selection with the best
+    // single codec of the same candidates.
+    static arrow::Status RunAdaptiveCodecBenchmark(int num_columns, int num_rows, const std::string& filename_prefix);
+    // RunBenchmark's matrix through arrow::io::BufferOutputStream and
+    // arrow::io::BufferReader instead of files, so disk and page cache costs
+    // stay out, with encoding, compression, decompression and decoding timed
+    // apart.
+    static arrow::Status RunInMemoryBenchmark(int num_columns, int num_rows, const std::string& filename_prefix);
+    static void WriteInMemoryResults(const std::vector<InMemoryBenchmarkResult>& results, const std::string& filename);
+
+    static void WriteAdaptiveCodecResults(const std::vector<AdaptiveCodecResult>& results, const std::string& filename);
+};
@@ -1,39 +1,91 @@
 #include "data_generator.h"
+#include "benchmark_memory.h"
+#include "synthetic_data.h"
 #include <parquet/arrow/writer.h>
 #include <arrow/io/file.h>
-#include <random>
+#include <algorithm>
 
-arrow::Status DataGenerator::WriteParquetFile(int num_columns, int num_rows, const std::string& filename,
-                                              StatsLevel stats_level) {
-    arrow::MemoryPool* pool = arrow::default_memory_pool();
-    std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
+namespace {
 
-    for (int i = 0; i < num_columns; ++i) {
-        schema_vector.push_back(arrow::field("col_" + std::to_string(i), arrow::float32()));
+// Batch i is generated from MixSeed(SyntheticDataSeed(), i), so the file holds
+// the same values on every run, though not those of WriteParquetFile.
+class RandomBatchReader : public arrow::RecordBatchReader {
+public:
+    RandomBatchReader(int num_columns, int64_t num_rows, int64_t batch_size, arrow::MemoryPool* pool)
+        : schema_(SyntheticSchema(num_columns)), rows_left_(num_rows), batch_size_(batch_size), pool_(pool) {}
 
-        arrow::FloatBuilder builder(pool);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+    std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
 
-        for (int j = 0; j < num_rows; ++j) {
-            ARROW_RETURN_NOT_OK(builder.Append(dis(gen)));
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+        if (rows_left_ == 0) {
+            batch->reset();
+            return arrow::Status::OK();
         }
+        int64_t num_rows = std::min(rows_left_, batch_size_);
+        SyntheticDataOptions options;
+        options.seed = MixSeed(options.seed, next_batch_++);
+        ARROW_ASSIGN_OR_RAISE(auto arrays, GenerateColumns(schema_->num_fields(), num_rows, pool_, {}, options));
+        rows_left_ -= num_rows;
+        *batch = arrow::RecordBatch::Make(schema_, num_rows, std::move(arrays));
+        return arrow::Status::OK();
+    }
+
+private:
+    std::shared_ptr<arrow::Schema> schema_;
+    int64_t rows_left_;
+    int64_t batch_size_;
+    arrow::MemoryPool* pool_;
+    uint64_t next_batch_ = 0;
+};
 
-        std::shared_ptr<arrow::Array> array;
-        ARROW_RETURN_NOT_OK(builder.Finish(&array));
-        arrays.push_back(array);
+}  // namespace
+
+const char* ColumnEncodingName(ColumnEncoding encoding) {
+    switch (encoding) {
+        case ColumnEncoding::PLAIN: return "plain";
+        case ColumnEncoding::DICTIONARY: return "dictionary";
+        case ColumnEncoding::BYTE_STREAM_SPLIT: return "byte_stream_split";
+        case ColumnEncoding::DELTA_BINARY_PACKED: return "delta_binary_packed";
     }
+    return "unknown";
+}
 
-    auto schema = std::make_shared<arrow::Schema>(schema_vector);
-    auto table = arrow::Table::Make(schema, arrays);
+bool SupportsEncoding(parquet::Type::type type, ColumnEncoding encoding) {
+    bool is_float = type == parquet::Type::FLOAT || type == parquet::Type::DOUBLE;
+    bool is_integer = type == parquet::Type::INT32 || type == parquet::Type::INT64;
+    switch (encoding) {
+        case ColumnEncoding::PLAIN:
+        case ColumnEncoding::DICTIONARY:
+            return true;
+        case ColumnEncoding::BYTE_STREAM_SPLIT:
+            return is_float;
+        case ColumnEncoding::DELTA_BINARY_PACKED:
+            return is_integer;
+    }
+    return false;
+}
 
-    std::shared_ptr<arrow::io::FileOutputStream> outfile;
-    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+void SetColumnEncoding(parquet::WriterProperties::Builder* builder, ColumnEncoding encoding) {
+    switch (encoding) {
+        case ColumnEncoding::PLAIN:
+            builder->disable_dictionary()->encoding(parquet::Encoding::PLAIN);
+            break;
+        case ColumnEncoding::DICTIONARY:
+            builder->enable_dictionary()->encoding(parquet::Encoding::PLAIN);
+            break;
+        case ColumnEncoding::BYTE_STREAM_SPLIT:
+            builder->disable_dictionary()->encoding(parquet::Encoding::BYTE_STREAM_SPLIT);
+            break;
+        case ColumnEncoding::DELTA_BINARY_PACKED:
+            builder->disable_dictionary()->encoding(parquet::Encoding::DELTA_BINARY_PACKED);
+            break;
+    }
+}
 
+std::shared_ptr<parquet::WriterProperties> DataGenerator::WriterProperties(StatsLevel stats_level) {
     parquet::WriterProperties::Builder builder;
     builder.version(parquet::ParquetVersion::PARQUET_2_6);
+    builder.max_row_group_length(10000);
 
     switch (stats_level) {
         case StatsLevel::NONE:
@@ -43,13 +95,46 @@ arrow::Status DataGenerator::WriteParquetFile(int num_columns, int num_rows, con
             builder.enable_statistics();
             break;
         case StatsLevel::PAGE:
+            // Page statistics go into the ColumnIndex, which is only written on request
             builder.enable_statistics();
-            // Note: Page index is enabled by default in newer versions
+            builder.enable_write_page_index();
             break;
     }
+    return builder.build();
+}
 
-    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, 10000, builder.build()));
+arrow::Status DataGenerator::WriteParquetFile(int num_columns, int num_rows, const std::string& filename,
+                                              StatsLevel stats_level) {
+    ARROW_ASSIGN_OR_RAISE(auto table, GenerateTable(num_columns, num_rows, BenchmarkMemoryPool()));
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), outfile, 10000,
+                                                   WriterProperties(stats_level)));
     ARROW_RETURN_NOT_OK(outfile->Close());
 
     return arrow::Status::OK();
-}
\ No newline at end of file
+}
+
+arrow::Result<StreamingWriteStats> DataGenerator::WriteParquetFileStreaming(int num_columns, int num_rows,
+                                                                            const std::string& filename,
+                                                                            const StreamingWriteOptions& options,
+                                                                            int64_t batch_size,
+                                                                            StatsLevel stats_level) {
+    auto batches = MakeBatchReader(num_columns, num_rows, batch_size, BenchmarkMemoryPool());
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+
+    ARROW_ASSIGN_OR_RAISE(auto stats, WriteParquetStream(batches.get(), BenchmarkMemoryPool(), outfile,
+                                                         *WriterProperties(stats_level), options));
+    ARROW_RETURN_NOT_OK(outfile->Close());
+    return stats;
+}
+
+std::shared_ptr<arrow::RecordBatchReader> DataGenerator::MakeBatchReader(int num_columns, int64_t num_rows,
+                                                                         int64_t batch_size,
+                                                                         arrow::MemoryPool* pool) {
+    return std::make_shared<RandomBatchReader>(num_columns, num_rows, batch_size, pool);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "streaming_writer.h"
 #include <arrow/api.h>
 #include <string>
 
@@ -8,8 +9,38 @@ enum class StatsLevel {
     PAGE
 };
 
+// Column encodings the sweeps compare. Each sets the encoding and turns
+// dictionary encoding on or off to match.
+enum class ColumnEncoding {
+    PLAIN,
+    // Dictionary pages, falling back to PLAIN once the dictionary outgrows its page
+    DICTIONARY,
+    // Floating point only
+    BYTE_STREAM_SPLIT,
+    // Integer only
+    DELTA_BINARY_PACKED,
+};
+
+const char* ColumnEncodingName(ColumnEncoding encoding);
+// Whether Parquet writes `encoding` for columns of physical type `type`.
+bool SupportsEncoding(parquet::Type::type type, ColumnEncoding encoding);
+void SetColumnEncoding(parquet::WriterProperties::Builder* builder, ColumnEncoding encoding);
+
 class DataGenerator {
 public:
     static arrow::Status WriteParquetFile(int num_columns, int num_rows, const std::string& filename, 
                                           StatsLevel stats_level = StatsLevel::NONE);
-};
\ No newline at end of file
+    // The same file written batch by batch through WriteParquetStream, so the
+    // whole table is never in memory. Row groups still end at 10000 rows, or
+    // earlier under options.memory_cap_bytes.
+    static arrow::Result<StreamingWriteStats> WriteParquetFileStreaming(int num_columns, int num_rows,
+                                                                        const std::string& filename,
+                                                                        const StreamingWriteOptions& options,
+                                                                        int64_t batch_size = 1024,
+                                                                        StatsLevel stats_level = StatsLevel::NONE);
+    // Columns like those WriteParquetFile writes, generated batch_size rows at a
+    // time as the batches are read, each batch from its own seed.
+    static std::shared_ptr<arrow::RecordBatchReader> MakeBatchReader(int num_columns, int64_t num_rows,
+                                                                     int64_t batch_size, arrow::MemoryPool* pool);
+    static std::shared_ptr<parquet::WriterProperties> WriterProperties(StatsLevel stats_level);
+};
@@ -1,53 +1,185 @@
 #include "data_read_benchmark.h"
+#include "benchmark_flags.h"
+#include "flatbuffer_footer.h"
+#include "metadata_cache.h"
+#include "synthetic_data.h"
 #include <arrow/io/file.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/io/memory.h>
+#include <arrow/util/compression.h>
+#include <arrow/util/thread_pool.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/column_page.h>
+#include <parquet/column_reader.h>
+#include <parquet/file_reader.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <random>
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <numeric>
+#include <thread>
+#include <unistd.h>
 
-arrow::Status DataReadBenchmark::GenerateParquetFile(int num_columns, int num_rows, const std::string& filename) {
-    arrow::MemoryPool* pool = arrow::default_memory_pool();
-    std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
+namespace {
 
-    for (int i = 0; i < num_columns; ++i) {
-        schema_vector.push_back(arrow::field("col_" + std::to_string(i), arrow::float32()));
+constexpr int kThreadScalingRepetitions = 3;
 
-        arrow::FloatBuilder builder(pool);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+// 1, 2, 4, ... up to and including max_threads
+std::vector<int> ThreadCounts(int max_threads) {
+    std::vector<int> counts;
+    for (int n = 1; n < max_threads; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// Hands out pages that were read and decompressed ahead of time, so a
+// ColumnReader over it spends its time decoding.
+class PreparedPageReader : public parquet::PageReader {
+public:
+    explicit PreparedPageReader(std::vector<std::shared_ptr<parquet::Page>> pages) : pages_(std::move(pages)) {}
+
+    std::shared_ptr<parquet::Page> NextPage() override {
+        return next_ < pages_.size() ? pages_[next_++] : nullptr;
+    }
+
+    void set_max_page_header_size(uint32_t) override {}
+
+private:
+    std::vector<std::shared_ptr<parquet::Page>> pages_;
+    size_t next_ = 0;
+};
+
+// Reads the next `num_values` levels, which is exactly one page.
+template <typename DType>
+void DecodePage(parquet::ColumnReader* reader, int32_t num_values, std::vector<int16_t>* def_levels,
+                std::vector<int16_t>* rep_levels, std::vector<uint8_t>* values) {
+    using T = typename DType::c_type;
+    auto* typed_reader = static_cast<parquet::TypedColumnReader<DType>*>(reader);
+    def_levels->resize(num_values);
+    rep_levels->resize(num_values);
+    values->resize(num_values * sizeof(T));
+    int64_t total_read = 0;
+    while (total_read < num_values) {
+        int64_t values_read = 0;
+        int64_t levels_read = typed_reader->ReadBatch(num_values - total_read, def_levels->data() + total_read,
+                                                      rep_levels->data() + total_read,
+                                                      reinterpret_cast<T*>(values->data()) + total_read, &values_read);
+        if (levels_read == 0) {
+            throw parquet::ParquetException("Page ended early");
+        }
+        total_read += levels_read;
+    }
+}
+
+double Percentile(std::vector<double> samples, double q) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+// Resident set size from /proc/self/statm, or 0 where that does not exist
+int64_t CurrentRssBytes() {
+    std::ifstream statm("/proc/self/statm");
+    int64_t size_pages = 0;
+    int64_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * sysconf(_SC_PAGESIZE);
+}
 
-        for (int j = 0; j < num_rows; ++j) {
-            ARROW_RETURN_NOT_OK(builder.Append(dis(gen)));
+// Samples the resident set every millisecond while alive.
+class RssSampler {
+public:
+    RssSampler() : peak_(CurrentRssBytes()), thread_([this]() {
+        while (!stop_) {
+            peak_ = std::max(peak_.load(), CurrentRssBytes());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
+    }) {}
 
-        std::shared_ptr<arrow::Array> array;
-        ARROW_RETURN_NOT_OK(builder.Finish(&array));
-        arrays.push_back(array);
+    ~RssSampler() {
+        stop_ = true;
+        thread_.join();
     }
 
-    auto schema = std::make_shared<arrow::Schema>(schema_vector);
-    auto table = arrow::Table::Make(schema, arrays);
+    int64_t peak() const { return std::max(peak_.load(), CurrentRssBytes()); }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::atomic<int64_t> peak_;
+    std::thread thread_;
+};
+
+double ElapsedMicros(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+}  // namespace
+
+arrow::Status DataReadBenchmark::GenerateParquetFile(int num_columns, int num_rows, const std::string& filename,
+                                                     int64_t row_group_size,
+                                                     std::shared_ptr<parquet::WriterProperties> properties) {
+    ARROW_ASSIGN_OR_RAISE(auto table, GenerateTable(num_columns, num_rows, BenchmarkMemoryPool()));
 
     std::shared_ptr<arrow::io::FileOutputStream> outfile;
     ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
 
-    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, 10000));
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), outfile, row_group_size,
+                                                   properties));
     ARROW_RETURN_NOT_OK(outfile->Close());
 
     return arrow::Status::OK();
 }
 
+// The decode timings start once the file is open, as --io=memory reads the
+// whole file in OpenInputFile.
 double DataReadBenchmark::MeasureMetadataDecodeTime(const std::string& filename) {
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_THROW_NOT_OK(OpenInputFile(filename).Value(&infile));
+
     auto start = std::chrono::high_resolution_clock::now();
-    
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    PARQUET_THROW_NOT_OK(arrow::io::ReadableFile::Open(filename).Value(&infile));
 
-    std::shared_ptr<parquet::arrow::FileReader> reader;
-    PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), reinterpret_cast<std::unique_ptr<parquet::arrow::FileReader, std::default_delete<parquet::arrow::FileReader>>*>(&reader)));
+    parquet::arrow::FileReaderBuilder builder;
+    PARQUET_THROW_NOT_OK(builder.Open(infile, parquet::ReaderProperties(BenchmarkMemoryPool())));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(builder.memory_pool(BenchmarkMemoryPool())->Build(&reader));
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double DataReadBenchmark::MeasureFlatbufferMetadataDecodeTime(const std::string& filename) {
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_THROW_NOT_OK(OpenInputFile(filename).Value(&infile));
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(OpenFileWithFlatbufferFooter(infile, BenchmarkMemoryPool(), {}, &reader));
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double DataReadBenchmark::MeasureCachedMetadataDecodeTime(const std::string& filename) {
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(OpenFileWithMetadataCache(filename, BenchmarkMemoryPool(), MetadataCache::Global(), &reader));
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_THROW_NOT_OK(OpenInputFile(filename).Value(&infile));
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    PARQUET_THROW_NOT_OK(
+        OpenFileWithMetadataCache(filename, infile, BenchmarkMemoryPool(), MetadataCache::Global(), &reader));
 
     auto end = std::chrono::high_resolution_clock::now();
     return std::chrono::duration<double, std::milli>(end - start).count();
@@ -64,12 +196,23 @@ double DataReadBenchmark::MeasureFullDataReadTime(const std::unique_ptr<parquet:
 }
 
 double DataReadBenchmark::MeasureRandomColumnReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader, int num_columns) {
-    auto start = std::chrono::high_resolution_clock::now();
+    return MeasureColumnReadTime(reader, RandomColumnIndices(num_columns));
+}
 
-    std::vector<int> column_indices;
-    for (int i = 0; i < num_columns / 2; ++i) {
-        column_indices.push_back(rand() % num_columns);
-    }
+std::vector<int> DataReadBenchmark::RandomColumnIndices(int num_columns) {
+    // Without replacement, so no column is read twice
+    std::vector<int> column_indices(num_columns);
+    std::iota(column_indices.begin(), column_indices.end(), 0);
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(SyntheticDataSeed()));
+    std::shuffle(column_indices.begin(), column_indices.end(), gen);
+    column_indices.resize(num_columns / 2);
+    std::sort(column_indices.begin(), column_indices.end());
+    return column_indices;
+}
+
+double DataReadBenchmark::MeasureColumnReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader,
+                                                const std::vector<int>& column_indices) {
+    auto start = std::chrono::high_resolution_clock::now();
 
     std::shared_ptr<arrow::Table> table;
     PARQUET_THROW_NOT_OK(reader->ReadTable(column_indices, &table));
@@ -81,21 +224,41 @@ double DataReadBenchmark::MeasureRandomColumnReadTime(const std::unique_ptr<parq
 double DataReadBenchmark::MeasurePageReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader) {
     auto start = std::chrono::high_resolution_clock::now();
 
-    auto file_metadata = reader->parquet_reader()->metadata();
-    int num_row_groups = file_metadata->num_row_groups();
-    int num_columns = file_metadata->num_columns();
+    auto parquet_reader = reader->parquet_reader();
+    int num_row_groups = parquet_reader->metadata()->num_row_groups();
+    int num_columns = parquet_reader->metadata()->num_columns();
 
-    for (int i = 0; i < num_row_groups; i += num_row_groups / 10) {  // Read every 10th row group
-    
-        std::shared_ptr<arrow::ChunkedArray> array;
-        PARQUET_THROW_NOT_OK(reader->ReadColumn(i, &array));
-        
+    for (int i = 0; i < num_row_groups; ++i) {
+        auto row_group = parquet_reader->RowGroup(i);
+        for (int c = 0; c < num_columns; ++c) {
+            auto page_reader = row_group->GetColumnPageReader(c);
+            while (page_reader->NextPage() != nullptr) {
+            }
+        }
     }
 
     auto end = std::chrono::high_resolution_clock::now();
     return std::chrono::duration<double, std::milli>(end - start).count();
 }
 
+arrow::Status DataReadBenchmark::MeasureColdReadTimes(const std::string& filename,
+                                                     const std::unique_ptr<parquet::arrow::FileReader>& reader,
+                                                     BenchmarkResult* result) {
+    ARROW_RETURN_NOT_OK(EvictFromPageCache(filename));
+    PARQUET_CATCH_NOT_OK(result->cold_metadata_decode_time_ms = MeasureMetadataDecodeTime(filename));
+    ARROW_RETURN_NOT_OK(EvictFromPageCache(filename));
+    PARQUET_CATCH_NOT_OK(result->cold_flatbuffer_metadata_decode_time_ms =
+                             MeasureFlatbufferMetadataDecodeTime(filename));
+    ARROW_RETURN_NOT_OK(EvictFromPageCache(filename));
+    PARQUET_CATCH_NOT_OK(result->cold_full_data_read_time_ms = MeasureFullDataReadTime(reader));
+    ARROW_RETURN_NOT_OK(EvictFromPageCache(filename));
+    PARQUET_CATCH_NOT_OK(result->cold_random_column_read_time_ms =
+                             MeasureRandomColumnReadTime(reader, reader->parquet_reader()->metadata()->num_columns()));
+    ARROW_RETURN_NOT_OK(EvictFromPageCache(filename));
+    PARQUET_CATCH_NOT_OK(result->cold_page_read_time_ms = MeasurePageReadTime(reader));
+    return arrow::Status::OK();
+}
+
 arrow::Status DataReadBenchmark::RunBenchmark(int num_columns, int num_rows, const std::string& filename) {
     ARROW_RETURN_NOT_OK(GenerateParquetFile(num_columns, num_rows, filename));
 
@@ -103,41 +266,706 @@ arrow::Status DataReadBenchmark::RunBenchmark(int num_columns, int num_rows, con
     result.num_columns = num_columns;
     result.num_rows = num_rows;
 
-    result.metadata_decode_time_ms = MeasureMetadataDecodeTime(filename);
-
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROW_ASSIGN_OR_RAISE(infile, arrow::io::ReadableFile::Open(filename));
+    // Both decode times are measured on the same file, which carries the
+    // FlatBuffer footer extension; Thrift readers skip over it.
+    ARROW_RETURN_NOT_OK(EmbedFlatbufferFooter(filename));
 
+    // Each phase starts from fresh counters. The reader opened for the data
+    // reads counts towards the full read.
+    std::vector<PhaseAllocationResult> allocations;
+    TrackingMemoryPool* pool = BenchmarkMemoryPool();
+    pool->ResetStats();
+    result.metadata_decode_time_ms = MeasureMetadataDecodeTime(filename);
+    allocations.push_back({num_columns, num_rows, "metadata_decode", pool->stats()});
+    pool->ResetStats();
+    result.flatbuffer_metadata_decode_time_ms = MeasureFlatbufferMetadataDecodeTime(filename);
+    allocations.push_back({num_columns, num_rows, "flatbuffer_metadata_decode", pool->stats()});
+    pool->ResetStats();
+    result.cached_metadata_decode_time_ms = MeasureCachedMetadataDecodeTime(filename);
+    allocations.push_back({num_columns, num_rows, "cached_metadata_decode", pool->stats()});
+    pool->ResetStats();
+
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    ARROW_ASSIGN_OR_RAISE(infile, OpenInputFile(filename));
+
+    parquet::arrow::FileReaderBuilder builder;
+    ARROW_RETURN_NOT_OK(builder.Open(infile, parquet::ReaderProperties(BenchmarkMemoryPool())));
     std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROW_RETURN_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+    ARROW_RETURN_NOT_OK(builder.memory_pool(BenchmarkMemoryPool())->Build(&reader));
 
     result.full_data_read_time_ms = MeasureFullDataReadTime(reader);
+    allocations.push_back({num_columns, num_rows, "full_read", pool->stats()});
+    pool->ResetStats();
     result.random_column_read_time_ms = MeasureRandomColumnReadTime(reader, num_columns);
+    allocations.push_back({num_columns, num_rows, "random_column_read", pool->stats()});
+    pool->ResetStats();
     result.page_read_time_ms = MeasurePageReadTime(reader);
+    allocations.push_back({num_columns, num_rows, "page_read", pool->stats()});
+
+    if (ColdCacheMode()) {
+        ARROW_RETURN_NOT_OK(MeasureColdReadTimes(filename, reader, &result));
+    }
 
     std::vector<BenchmarkResult> results = {result};
     WriteBenchmarkResults(results, filename + "_benchmark_results.csv");
+    WriteAllocationResults(allocations, filename + "_allocation_results.csv");
 
     return arrow::Status::OK();
 }
 
 void DataReadBenchmark::WriteBenchmarkResults(const std::vector<BenchmarkResult>& results, const std::string& filename) {
     std::ofstream file(filename);
-    file << "num_columns,num_rows,metadata_decode_time_ms,full_data_read_time_ms,random_column_read_time_ms,page_read_time_ms\n";
+    bool cold = ColdCacheMode();
+    file << "num_columns,num_rows,metadata_decode_time_ms,full_data_read_time_ms,random_column_read_time_ms,page_read_time_ms,flatbuffer_metadata_decode_time_ms,cached_metadata_decode_time_ms,memory_pool";
+    if (cold) {
+        file << ",cold_metadata_decode_time_ms,cold_full_data_read_time_ms,cold_random_column_read_time_ms,"
+             << "cold_page_read_time_ms,cold_flatbuffer_metadata_decode_time_ms";
+    }
+    file << "\n";
     for (const auto& result : results) {
         file << result.num_columns << ","
              << result.num_rows << ","
              << result.metadata_decode_time_ms << ","
              << result.full_data_read_time_ms << ","
              << result.random_column_read_time_ms << ","
-             << result.page_read_time_ms << "\n";
+             << result.page_read_time_ms << ","
+             << result.flatbuffer_metadata_decode_time_ms << ","
+             << result.cached_metadata_decode_time_ms << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend());
+        if (cold) {
+            file << "," << result.cold_metadata_decode_time_ms
+                 << "," << result.cold_full_data_read_time_ms
+                 << "," << result.cold_random_column_read_time_ms
+                 << "," << result.cold_page_read_time_ms
+                 << "," << result.cold_flatbuffer_metadata_decode_time_ms;
+        }
+        file << "\n";
+    }
+}
+
+void DataReadBenchmark::WriteAllocationResults(const std::vector<PhaseAllocationResult>& results,
+                                               const std::string& filename) {
+    std::ofstream file(filename);
+    file << "num_columns,num_rows,memory_pool,phase,allocations,reallocations,frees,bytes_allocated,peak_bytes\n";
+    for (const auto& result : results) {
+        file << result.num_columns << ","
+             << result.num_rows << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << ","
+             << result.phase << ","
+             << result.stats.allocations << ","
+             << result.stats.reallocations << ","
+             << result.stats.frees << ","
+             << result.stats.bytes_allocated << ","
+             << result.stats.peak_bytes << "\n";
+    }
+}
+
+double DataReadBenchmark::MeasureConfiguredReadTime(const std::string& filename,
+                                                    const parquet::ArrowReaderProperties& properties,
+                                                    int cpu_threads, int io_threads,
+                                                    const std::vector<int>& column_indices) {
+    PARQUET_THROW_NOT_OK(arrow::SetCpuThreadPoolCapacity(cpu_threads));
+    PARQUET_THROW_NOT_OK(arrow::io::SetIOThreadPoolCapacity(io_threads));
+
+    double best_time = 0;
+    for (int i = 0; i < kThreadScalingRepetitions; ++i) {
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+        std::shared_ptr<arrow::io::RandomAccessFile> infile;
+        PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename));
+        auto start = std::chrono::high_resolution_clock::now();
+
+        parquet::arrow::FileReaderBuilder builder;
+        PARQUET_THROW_NOT_OK(builder.Open(infile, parquet::ReaderProperties(BenchmarkMemoryPool())));
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(builder.memory_pool(BenchmarkMemoryPool())->properties(properties)->Build(&reader));
+
+        std::shared_ptr<arrow::Table> table;
+        if (column_indices.empty()) {
+            PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+        } else {
+            PARQUET_THROW_NOT_OK(reader->ReadTable(column_indices, &table));
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration<double, std::milli>(end - start).count();
+        best_time = i == 0 ? time : std::min(best_time, time);
+    }
+    return best_time;
+}
+
+arrow::Status DataReadBenchmark::RunThreadScalingBenchmark(int num_columns, int num_rows, const std::string& filename) {
+    ARROW_RETURN_NOT_OK(GenerateParquetFile(num_columns, num_rows, filename));
+
+    // MeasureConfiguredReadTime resizes the pools; they are put back however the sweep ends
+    ThreadPoolCapacityRestorer restorer;
+    int default_io_threads = restorer.io_threads();
+    int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Every other column, so projected reads skip half the column chunks
+    std::vector<int> projection;
+    for (int i = 0; i < num_columns; i += 2) {
+        projection.push_back(i);
+    }
+
+    std::vector<ThreadScalingResult> results;
+    for (const std::string read_type : {"full", "projected"}) {
+        std::vector<int> column_indices;
+        if (read_type == "projected") {
+            column_indices = projection;
+        }
+
+        parquet::ArrowReaderProperties serial_properties;
+        serial_properties.set_use_threads(false);
+        serial_properties.set_pre_buffer(false);
+        double serial_time = MeasureConfiguredReadTime(filename, serial_properties, 1, 1, column_indices);
+        results.push_back({num_columns, num_rows, read_type, false, false, 1, 1, serial_time, 1.0, 1.0});
+
+        for (bool pre_buffer : {false, true}) {
+            for (int cpu_threads : ThreadCounts(max_threads)) {
+                // The I/O pool only serves pre-buffered reads; sweep it alongside the
+                // CPU pool and also keep it at Arrow's default size.
+                std::vector<int> io_thread_counts = {cpu_threads};
+                if (pre_buffer && cpu_threads != default_io_threads) {
+                    io_thread_counts.push_back(default_io_threads);
+                }
+                for (int io_threads : io_thread_counts) {
+                    parquet::ArrowReaderProperties properties;
+                    properties.set_use_threads(true);
+                    properties.set_pre_buffer(pre_buffer);
+                    double time = MeasureConfiguredReadTime(filename, properties, cpu_threads, io_threads,
+                                                            column_indices);
+                    double speedup = serial_time / time;
+                    results.push_back({num_columns, num_rows, read_type, true, pre_buffer, cpu_threads, io_threads,
+                                       time, speedup, speedup / cpu_threads});
+                }
+            }
+        }
+    }
+
+    WriteThreadScalingResults(results, filename + "_thread_scaling_results.csv");
+    return arrow::Status::OK();
+}
+
+void DataReadBenchmark::WriteThreadScalingResults(const std::vector<ThreadScalingResult>& results,
+                                                  const std::string& filename) {
+    std::ofstream file(filename);
+    file << "num_columns,num_rows,read_type,use_threads,pre_buffer,cpu_threads,io_threads,read_time_ms,speedup,efficiency,memory_pool\n";
+    for (const auto& result : results) {
+        file << result.num_columns << ","
+             << result.num_rows << ","
+             << result.read_type << ","
+             << result.use_threads << ","
+             << result.pre_buffer << ","
+             << result.cpu_threads << ","
+             << result.io_threads << ","
+             << result.read_time_ms << ","
+             << result.speedup << ","
+             << result.efficiency << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
+
+CoalescingResult DataReadBenchmark::MeasureCoalescedColumnReadTime(const std::string& filename,
+                                                                   const SimulatedStorageOptions& storage,
+                                                                   bool pre_buffer,
+                                                                   const arrow::io::CacheOptions& cache_options,
+                                                                   const std::vector<int>& column_indices) {
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename, DefaultIoBackend()));
+    std::shared_ptr<SimulatedStorageFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, SimulatedStorageFile::Make(infile, storage));
+
+    parquet::ArrowReaderProperties properties;
+    properties.set_pre_buffer(pre_buffer);
+    properties.set_cache_options(cache_options);
+    parquet::arrow::FileReaderBuilder builder;
+    PARQUET_THROW_NOT_OK(builder.Open(file, parquet::ReaderProperties(BenchmarkMemoryPool())));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(builder.memory_pool(BenchmarkMemoryPool())->properties(properties)->Build(&reader));
+    file->ResetStats();
+    PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+
+    CoalescingResult result;
+    result.read_time_ms = MeasureColumnReadTime(reader, column_indices);
+    IoStats stats = file->stats();
+    result.io_requests = stats.requests;
+    result.bytes_read = stats.bytes_read;
+
+    auto metadata = reader->parquet_reader()->metadata();
+    std::vector<bool> selected(metadata->num_columns(), false);
+    for (int i : column_indices) {
+        selected[i] = true;
+    }
+    result.bytes_needed = 0;
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        auto row_group = metadata->RowGroup(rg);
+        for (int c = 0; c < metadata->num_columns(); ++c) {
+            if (selected[c]) {
+                result.bytes_needed += row_group->ColumnChunk(c)->total_compressed_size();
+            }
+        }
     }
+    result.over_read_bytes = result.bytes_read - result.bytes_needed;
+    result.pre_buffer = pre_buffer;
+    result.hole_size_limit = pre_buffer ? cache_options.hole_size_limit : 0;
+    result.range_size_limit = pre_buffer ? cache_options.range_size_limit : 0;
+    return result;
 }
 
-int main() {
+arrow::Status DataReadBenchmark::RunCoalescingBenchmark(int num_columns, int num_rows, const std::string& filename) {
+    ARROW_RETURN_NOT_OK(GenerateParquetFile(num_columns, num_rows, filename));
+
+    // The same projection for every configuration
+    std::vector<int> column_indices = RandomColumnIndices(num_columns);
+
+    // A high-latency object store, unless --latency-ms and friends describe another
+    SimulatedStorageOptions remote;
+    remote.latency = std::chrono::milliseconds(10);
+    remote.bandwidth_bytes_per_second = 500LL * 1024 * 1024;
+    if (auto configured = DefaultSimulatedStorage()) {
+        remote = *configured;
+    }
+    std::vector<std::pair<std::string, SimulatedStorageOptions>> tiers = {{"local", SimulatedStorageOptions()},
+                                                                         {"simulated", remote}};
+
+    std::vector<CoalescingResult> results;
+    for (const auto& [storage, storage_options] : tiers) {
+        std::vector<std::pair<bool, arrow::io::CacheOptions>> configurations;
+        configurations.emplace_back(false, arrow::io::CacheOptions::LazyDefaults());
+        for (int64_t hole_size_limit : {0LL, 8LL * 1024, 64LL * 1024, 1024LL * 1024}) {
+            for (int64_t range_size_limit : {1LL << 20, 8LL << 20, 32LL << 20, 128LL << 20}) {
+                auto cache_options = arrow::io::CacheOptions::LazyDefaults();
+                cache_options.hole_size_limit = hole_size_limit;
+                cache_options.range_size_limit = range_size_limit;
+                configurations.emplace_back(true, cache_options);
+            }
+        }
+        if (storage_options.bandwidth_bytes_per_second > 0) {
+            // Arrow's own suggestion for this latency and bandwidth
+            auto cache_options = arrow::io::CacheOptions::MakeFromNetworkMetrics(
+                std::chrono::duration_cast<std::chrono::milliseconds>(storage_options.latency).count(),
+                storage_options.bandwidth_bytes_per_second >> 20);
+            configurations.emplace_back(true, cache_options);
+        }
+
+        for (const auto& [pre_buffer, cache_options] : configurations) {
+            auto result = MeasureCoalescedColumnReadTime(filename, storage_options, pre_buffer, cache_options,
+                                                         column_indices);
+            result.num_columns = num_columns;
+            result.num_rows = num_rows;
+            result.storage = storage;
+            results.push_back(result);
+        }
+    }
+
+    WriteCoalescingResults(results, filename + "_coalescing_results.csv");
+    return arrow::Status::OK();
+}
+
+void DataReadBenchmark::WriteCoalescingResults(const std::vector<CoalescingResult>& results,
+                                               const std::string& filename) {
+    std::ofstream file(filename);
+    file << "num_columns,num_rows,storage,pre_buffer,hole_size_limit,range_size_limit,io_requests,bytes_read,bytes_needed,over_read_bytes,read_time_ms,memory_pool\n";
+    for (const auto& result : results) {
+        file << result.num_columns << ","
+             << result.num_rows << ","
+             << result.storage << ","
+             << result.pre_buffer << ","
+             << result.hole_size_limit << ","
+             << result.range_size_limit << ","
+             << result.io_requests << ","
+             << result.bytes_read << ","
+             << result.bytes_needed << ","
+             << result.over_read_bytes << ","
+             << result.read_time_ms << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
+
+ArenaResult DataReadBenchmark::MeasureScratchPoolRead(const std::string& filename, int64_t arena_capacity) {
+    std::unique_ptr<ArenaMemoryPool> arena;
+    if (arena_capacity > 0) {
+        PARQUET_ASSIGN_OR_THROW(arena, ArenaMemoryPool::Make(arena_capacity, BenchmarkMemoryPool()));
+    }
+    arrow::MemoryPool* scratch_pool = arena ? static_cast<arrow::MemoryPool*>(arena.get()) : BenchmarkMemoryPool();
+
+    // Hand memory kept from earlier reads back to the system, so each
+    // configuration grows the resident set from a similar baseline
+    BenchmarkMemoryPool()->ReleaseUnused();
+    int64_t baseline_rss = CurrentRssBytes();
+    RssSampler rss_sampler;
+
+    ArenaResult result = {};
+    result.scratch_pool = arena ? "arena" : "default";
+    result.arena_capacity = arena_capacity;
+    for (int i = 0; i < kThreadScalingRepetitions; ++i) {
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+        std::shared_ptr<arrow::io::RandomAccessFile> infile;
+        PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename));
+        auto start = std::chrono::high_resolution_clock::now();
+
+        parquet::arrow::FileReaderBuilder builder;
+        PARQUET_THROW_NOT_OK(builder.Open(infile, parquet::ReaderProperties(scratch_pool)));
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(builder.memory_pool(BenchmarkMemoryPool())->Build(&reader));
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+
+        auto end = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration<double, std::milli>(end - start).count();
+        result.read_time_ms = i == 0 ? time : std::min(result.read_time_ms, time);
+        result.num_columns = table->num_columns();
+        result.num_rows = table->num_rows();
+    }
+
+    double uncompressed_mb =
+        static_cast<double>(result.num_columns) * result.num_rows * sizeof(float) / (1024.0 * 1024.0);
+    result.throughput_mb_s = uncompressed_mb / (result.read_time_ms / 1000.0);
+    result.peak_rss_growth_mb = (rss_sampler.peak() - baseline_rss) / (1024.0 * 1024.0);
+    if (arena) {
+        result.arena_allocations = arena->arena_allocations();
+        result.fallback_allocations = arena->fallback_allocations();
+        result.rewinds = arena->rewinds();
+    }
+    return result;
+}
+
+arrow::Status DataReadBenchmark::RunArenaBenchmark(int num_columns, int num_rows, const std::string& filename) {
+    // Compressed, so every column chunk needs decompression buffers from the
+    // Parquet reader's pool; the level and value buffers come from the Arrow pool
+    parquet::WriterProperties::Builder builder;
+    builder.compression(parquet::Compression::SNAPPY);
+    ARROW_RETURN_NOT_OK(GenerateParquetFile(num_columns, num_rows, filename, 1000, builder.build()));
+
+    std::vector<ArenaResult> results;
+    // Untimed, so the first configuration does not pay for the cold file
+    PARQUET_CATCH_NOT_OK(MeasureScratchPoolRead(filename, 0));
+    for (int64_t arena_capacity : {0, 1 << 20, 16 << 20, 64 << 20}) {
+        PARQUET_CATCH_NOT_OK(results.push_back(MeasureScratchPoolRead(filename, arena_capacity)));
+    }
+
+    WriteArenaResults(results, filename + "_arena_results.csv");
+    return arrow::Status::OK();
+}
+
+void DataReadBenchmark::WriteArenaResults(const std::vector<ArenaResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    file << "num_columns,num_rows,scratch_pool,arena_capacity,read_time_ms,throughput_mb_s,peak_rss_growth_mb,"
+         << "arena_allocations,fallback_allocations,rewinds,memory_pool\n";
+    for (const auto& result : results) {
+        file << result.num_columns << ","
+             << result.num_rows << ","
+             << result.scratch_pool << ","
+             << result.arena_capacity << ","
+             << result.read_time_ms << ","
+             << result.throughput_mb_s << ","
+             << result.peak_rss_growth_mb << ","
+             << result.arena_allocations << ","
+             << result.fallback_allocations << ","
+             << result.rewinds << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
+
+std::vector<PageTiming> DataReadBenchmark::MeasurePageTimings(const std::string& filename) {
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(filename));
+    auto parquet_reader = parquet::ParquetFileReader::Open(file, parquet::ReaderProperties(BenchmarkMemoryPool()));
+    auto metadata = parquet_reader->metadata();
+
+    std::vector<PageTiming> timings;
+    std::vector<int16_t> def_levels;
+    std::vector<int16_t> rep_levels;
+    std::vector<uint8_t> values;
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        auto row_group = metadata->RowGroup(rg);
+        for (int c = 0; c < metadata->num_columns(); ++c) {
+            auto column_chunk = row_group->ColumnChunk(c);
+            int64_t chunk_start = column_chunk->has_dictionary_page() && column_chunk->dictionary_page_offset() > 0
+                                      ? column_chunk->dictionary_page_offset()
+                                      : column_chunk->data_page_offset();
+            std::shared_ptr<arrow::Buffer> chunk;
+            PARQUET_ASSIGN_OR_THROW(chunk, file->ReadAt(chunk_start, column_chunk->total_compressed_size()));
+            std::unique_ptr<arrow::util::Codec> codec;
+            PARQUET_ASSIGN_OR_THROW(codec, arrow::util::Codec::Create(column_chunk->compression()));
+
+            // Opened as uncompressed, the page reader hands out the stored bytes
+            // and leaves decompression to us.
+            auto page_reader = parquet::PageReader::Open(std::make_shared<arrow::io::BufferReader>(chunk),
+                                                         column_chunk->num_values(),
+                                                         parquet::Compression::UNCOMPRESSED,
+                                                         parquet::ReaderProperties(BenchmarkMemoryPool()));
+            std::vector<std::shared_ptr<parquet::Page>> pages;
+            size_t first_timing = timings.size();
+            while (auto page = page_reader->NextPage()) {
+                // parquet::DictionaryPage does not carry the uncompressed size
+                // its header stores, so it cannot be decompressed here
+                if (page->type() == parquet::PageType::DICTIONARY_PAGE) {
+                    throw parquet::ParquetException("Dictionary pages are not supported; write ", filename,
+                                                    " with the dictionary disabled");
+                } else if (page->type() != parquet::PageType::DATA_PAGE) {
+                    throw parquet::ParquetException("Unsupported page type ", static_cast<int>(page->type()));
+                }
+                const auto& data_page = static_cast<const parquet::DataPageV1&>(*page);
+                std::shared_ptr<arrow::Buffer> data = page->buffer();
+                int64_t uncompressed_size = data_page.uncompressed_size();
+
+                auto start = std::chrono::high_resolution_clock::now();
+                if (codec) {
+                    std::shared_ptr<arrow::Buffer> decompressed;
+                    PARQUET_ASSIGN_OR_THROW(decompressed, arrow::AllocateBuffer(uncompressed_size, BenchmarkMemoryPool()));
+                    PARQUET_THROW_NOT_OK(codec->Decompress(data->size(), data->data(), uncompressed_size,
+                                                           decompressed->mutable_data()));
+                    data = decompressed;
+                }
+                double decompress_time_us = ElapsedMicros(start);
+
+                pages.push_back(std::make_shared<parquet::DataPageV1>(
+                    data, data_page.num_values(), data_page.encoding(), data_page.definition_level_encoding(),
+                    data_page.repetition_level_encoding(), uncompressed_size));
+                timings.push_back({page->buffer()->size(), uncompressed_size, data_page.num_values(),
+                                   decompress_time_us, 0});
+            }
+
+            auto column_reader = parquet::ColumnReader::Make(metadata->schema()->Column(c),
+                                                             std::make_unique<PreparedPageReader>(std::move(pages)));
+            for (size_t i = first_timing; i < timings.size(); ++i) {
+                auto start = std::chrono::high_resolution_clock::now();
+                switch (column_reader->type()) {
+                    case parquet::Type::INT32:
+                        DecodePage<parquet::Int32Type>(column_reader.get(), timings[i].num_values, &def_levels,
+                                                       &rep_levels, &values);
+                        break;
+                    case parquet::Type::INT64:
+                        DecodePage<parquet::Int64Type>(column_reader.get(), timings[i].num_values, &def_levels,
+                                                       &rep_levels, &values);
+                        break;
+                    case parquet::Type::FLOAT:
+                        DecodePage<parquet::FloatType>(column_reader.get(), timings[i].num_values, &def_levels,
+                                                       &rep_levels, &values);
+                        break;
+                    case parquet::Type::DOUBLE:
+                        DecodePage<parquet::DoubleType>(column_reader.get(), timings[i].num_values, &def_levels,
+                                                        &rep_levels, &values);
+                        break;
+                    default:
+                        throw parquet::ParquetException("Unsupported physical type for page decoding");
+                }
+                timings[i].decode_time_us = ElapsedMicros(start);
+            }
+        }
+    }
+    return timings;
+}
+
+arrow::Status DataReadBenchmark::RunPageSizeBenchmark(int num_columns, int num_rows,
+                                                      const std::string& filename_prefix) {
+    std::vector<PageReadResult> results;
+    std::vector<std::pair<int64_t, std::vector<PageTiming>>> all_timings;
+    // The page sizes metadata_benchmark writes
+    for (int64_t page_size : {8 * 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024}) {
+        std::string filename = filename_prefix + "_" + std::to_string(page_size) + "ps.parquet";
+        // One row group, no dictionary and no row limit per page, so every chunk
+        // is a run of PLAIN pages of the requested size.
+        parquet::WriterProperties::Builder builder;
+        builder.compression(parquet::Compression::SNAPPY)
+            ->disable_dictionary()
+            ->data_pagesize(page_size)
+            ->max_rows_per_page(num_rows);
+        ARROW_RETURN_NOT_OK(GenerateParquetFile(num_columns, num_rows, filename, num_rows, builder.build()));
+
+        std::vector<PageTiming> timings;
+        PARQUET_CATCH_NOT_OK(timings = MeasurePageTimings(filename));
+        std::remove(filename.c_str());
+
+        PageReadResult result = {};
+        result.num_columns = num_columns;
+        result.num_rows = num_rows;
+        result.page_size = page_size;
+        result.num_pages = timings.size();
+        std::vector<double> decompress_times;
+        std::vector<double> decode_times;
+        for (const auto& timing : timings) {
+            result.compressed_bytes += timing.compressed_size;
+            result.uncompressed_bytes += timing.uncompressed_size;
+            result.decompress_time_ms += timing.decompress_time_us / 1000.0;
+            result.decode_time_ms += timing.decode_time_us / 1000.0;
+            decompress_times.push_back(timing.decompress_time_us);
+            decode_times.push_back(timing.decode_time_us);
+        }
+        double uncompressed_mb = result.uncompressed_bytes / (1024.0 * 1024.0);
+        result.decompress_throughput_mb_s = result.decompress_time_ms > 0
+                                                ? uncompressed_mb / (result.decompress_time_ms / 1000.0) : 0;
+        result.decode_throughput_mb_s = result.decode_time_ms > 0 ? uncompressed_mb / (result.decode_time_ms / 1000.0)
+                                                                  : 0;
+        result.decompress_p50_us = Percentile(decompress_times, 0.5);
+        result.decompress_p99_us = Percentile(decompress_times, 0.99);
+        result.decode_p50_us = Percentile(decode_times, 0.5);
+        result.decode_p99_us = Percentile(decode_times, 0.99);
+        results.push_back(result);
+        all_timings.emplace_back(page_size, std::move(timings));
+    }
+
+    WritePageReadResults(results, filename_prefix + "_page_read_results.csv");
+    WritePageLatencyHistograms(all_timings, filename_prefix + "_page_latency_histogram.csv");
+    return arrow::Status::OK();
+}
+
+void DataReadBenchmark::WritePageReadResults(const std::vector<PageReadResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    file << "num_columns,num_rows,page_size,num_pages,compressed_bytes,uncompressed_bytes,decompress_time_ms,"
+         << "decode_time_ms,decompress_throughput_mb_s,decode_throughput_mb_s,decompress_p50_us,decompress_p99_us,"
+         << "decode_p50_us,decode_p99_us,memory_pool\n";
+    for (const auto& result : results) {
+        file << result.num_columns << ","
+             << result.num_rows << ","
+             << result.page_size << ","
+             << result.num_pages << ","
+             << result.compressed_bytes << ","
+             << result.uncompressed_bytes << ","
+             << result.decompress_time_ms << ","
+             << result.decode_time_ms << ","
+             << result.decompress_throughput_mb_s << ","
+             << result.decode_throughput_mb_s << ","
+             << result.decompress_p50_us << ","
+             << result.decompress_p99_us << ","
+             << result.decode_p50_us << ","
+             << result.decode_p99_us << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
+    }
+}
+
+// Buckets are powers of two in microseconds; bucket_us is the lower bound, and
+// the first bucket also holds everything under 1 us.
+void DataReadBenchmark::WritePageLatencyHistograms(
+        const std::vector<std::pair<int64_t, std::vector<PageTiming>>>& timings, const std::string& filename) {
+    std::ofstream file(filename);
+    file << "page_size,phase,bucket_us,count\n";
+    for (const auto& [page_size, page_timings] : timings) {
+        for (const char* phase : {"decompress", "decode"}) {
+            std::vector<int64_t> counts;
+            for (const auto& timing : page_timings) {
+                double time_us = std::string(phase) == "decompress" ? timing.decompress_time_us
+                                                                    : timing.decode_time_us;
+                size_t bucket = time_us < 1 ? 0 : static_cast<size_t>(std::log2(time_us));
+                if (bucket >= counts.size()) {
+                    counts.resize(bucket + 1, 0);
+                }
+                ++counts[bucket];
+            }
+            for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+                file << page_size << "," << phase << "," << (int64_t(1) << bucket) << "," << counts[bucket] << "\n";
+            }
+        }
+    }
+}
+
+// Usage: data_read_benchmark [I/O flags] [--pool=<backend>]
+//            [--thread-sweep [num_columns...] | --coalescing-sweep [num_columns...] | --page-sweep |
+//             --arena-sweep [num_columns...]]
+//
+// Without arguments, runs the default read benchmarks, which also write the
+// allocations of each phase to <file>_allocation_results.csv. --thread-sweep
+// instead writes <file>_thread_scaling_results.csv for each column count,
+// --coalescing-sweep writes <file>_coalescing_results.csv for 10000-row files
+// (10000 columns by default), and --page-sweep writes per-page timings for
+// page sizes from 8 KB to 8 MB. --arena-sweep writes
+// <file>_arena_results.csv for 10000-row files (1000, 5000 and 10000 columns by
+// default). With --cold, the default benchmarks also repeat each phase but the
+// cached metadata decode on an evicted file, written as cold_* columns next to
+// the warm ones, and the sweeps evict the file before every timed read. See
+// ParseBenchmarkFlags for the I/O flags, --pool and --seed.
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     std::vector<int> column_counts = {10, 100, 1000};
     int num_rows = 100000;  
 
+    if (argc > 1 && std::string(argv[1]) == "--thread-sweep") {
+        if (argc > 2) {
+            column_counts.clear();
+            for (int i = 2; i < argc; ++i) {
+                column_counts.push_back(std::stoi(argv[i]));
+            }
+        }
+        for (int num_columns : column_counts) {
+            std::string filename = "data_read_benchmark_" + std::to_string(num_columns) + ".parquet";
+            std::cout << "Running thread scaling sweep for " << num_columns << " columns..." << std::endl;
+
+            auto status = DataReadBenchmark::RunThreadScalingBenchmark(num_columns, num_rows, filename);
+            if (!status.ok()) {
+                std::cerr << "Error running thread scaling sweep for " << num_columns << " columns: "
+                          << status.ToString() << std::endl;
+                return 1;
+            }
+            std::remove(filename.c_str());
+        }
+        std::cout << "Thread scaling sweeps completed successfully. Results saved to CSV files." << std::endl;
+        return 0;
+    } else if (argc > 1 && std::string(argv[1]) == "--coalescing-sweep") {
+        column_counts = {10000};
+        if (argc > 2) {
+            column_counts.clear();
+            for (int i = 2; i < argc; ++i) {
+                column_counts.push_back(std::stoi(argv[i]));
+            }
+        }
+        for (int num_columns : column_counts) {
+            std::string filename = "data_read_benchmark_" + std::to_string(num_columns) + ".parquet";
+            std::cout << "Running coalescing sweep for " << num_columns << " columns..." << std::endl;
+
+            auto status = DataReadBenchmark::RunCoalescingBenchmark(num_columns, 10000, filename);
+            if (!status.ok()) {
+                std::cerr << "Error running coalescing sweep for " << num_columns << " columns: "
+                          << status.ToString() << std::endl;
+                return 1;
+            }
+            std::remove(filename.c_str());
+        }
+        std::cout << "Coalescing sweeps completed successfully. Results saved to CSV files." << std::endl;
+        return 0;
+    } else if (argc > 1 && std::string(argv[1]) == "--page-sweep") {
+        // 16 MB float32 chunks, so even 8 MB pages split each chunk
+        std::cout << "Running page size sweep..." << std::endl;
+        auto status = DataReadBenchmark::RunPageSizeBenchmark(10, 4000000, "data_read_benchmark_pages");
+        if (!status.ok()) {
+            std::cerr << "Error running page size sweep: " << status.ToString() << std::endl;
+            return 1;
+        }
+        std::cout << "Page size sweep completed successfully. Results saved to CSV files." << std::endl;
+        return 0;
+    } else if (argc > 1 && std::string(argv[1]) == "--arena-sweep") {
+        column_counts = {1000, 5000, 10000};
+        if (argc > 2) {
+            column_counts.clear();
+            for (int i = 2; i < argc; ++i) {
+                column_counts.push_back(std::stoi(argv[i]));
+            }
+        }
+        for (int num_columns : column_counts) {
+            std::string filename = "data_read_benchmark_" + std::to_string(num_columns) + ".parquet";
+            std::cout << "Running arena sweep for " << num_columns << " columns..." << std::endl;
+
+            auto status = DataReadBenchmark::RunArenaBenchmark(num_columns, 10000, filename);
+            if (!status.ok()) {
+                std::cerr << "Error running arena sweep for " << num_columns << " columns: "
+                          << status.ToString() << std::endl;
+                return 1;
+            }
+            std::remove(filename.c_str());
+        }
+        std::cout << "Arena sweeps completed successfully. Results saved to CSV files." << std::endl;
+        return 0;
+    } else if (argc > 1) {
+        std::cerr << "Usage: " << argv[0] << " [I/O flags] [--pool=<backend>] [--seed=<n>] [--thread-sweep [num_columns...] | "
+                  << "--coalescing-sweep [num_columns...] | --page-sweep | --arena-sweep [num_columns...]]"
+                  << std::endl;
+        return 1;
+    }
+
     for (int num_columns : column_counts) {
         std::string filename = "data_read_benchmark_" + std::to_string(num_columns) + ".parquet";
         std::cout << "Running benchmark for " << num_columns << " columns..." << std::endl;
@@ -148,9 +976,12 @@ int main() {
                       << status.ToString() << std::endl;
             return 1;
         }
+        MetadataCache::Global()->Invalidate(filename);
         std::remove(filename.c_str());
     }
 
+    auto cache_stats = MetadataCache::Global()->stats();
+    std::cout << "Metadata cache: " << cache_stats.hits << " hits, " << cache_stats.misses << " misses" << std::endl;
     std::cout << "All benchmarks completed successfully. Results saved to CSV files." << std::endl;
     return 0;
 }
\ No newline at end of file
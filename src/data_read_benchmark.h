@@ -2,7 +2,11 @@
 #define DATA_READ_BENCHMARK_H
 
 #include <arrow/api.h>
+#include <arrow/io/caching.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/properties.h>
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
 #include <string>
 #include <vector>
 
@@ -13,17 +17,168 @@ struct BenchmarkResult {
     double full_data_read_time_ms;
     double random_column_read_time_ms;
     double page_read_time_ms;
+    double flatbuffer_metadata_decode_time_ms;
+    double cached_metadata_decode_time_ms;
+    // The same phases with the file evicted from the page cache first; only
+    // measured in cold cache mode
+    double cold_metadata_decode_time_ms = 0;
+    double cold_flatbuffer_metadata_decode_time_ms = 0;
+    double cold_full_data_read_time_ms = 0;
+    double cold_random_column_read_time_ms = 0;
+    double cold_page_read_time_ms = 0;
+};
+
+// Allocations from BenchmarkMemoryPool() during one phase of RunBenchmark.
+struct PhaseAllocationResult {
+    int num_columns;
+    int num_rows;
+    std::string phase;
+    AllocationStats stats;
+};
+
+// One read under one ArrowReaderProperties/thread pool configuration. Speedup and
+// efficiency are relative to the single-threaded read of the same columns.
+struct ThreadScalingResult {
+    int num_columns;
+    int num_rows;
+    std::string read_type;  // "full" or "projected"
+    bool use_threads;
+    bool pre_buffer;
+    int cpu_threads;
+    int io_threads;
+    double read_time_ms;
+    double speedup;
+    double efficiency;
+};
+
+// A projected read under one storage tier and pre-buffering configuration.
+// bytes_needed is the compressed size of the projected column chunks, so
+// over_read_bytes is what coalescing fetched from the holes between them.
+struct CoalescingResult {
+    int num_columns;
+    int num_rows;
+    std::string storage;  // "local" or "simulated"
+    bool pre_buffer;
+    int64_t hole_size_limit;
+    int64_t range_size_limit;
+    int64_t io_requests;
+    int64_t bytes_read;
+    int64_t bytes_needed;
+    int64_t over_read_bytes;
+    double read_time_ms;
+};
+
+// A full read with decode scratch memory from either BenchmarkMemoryPool()
+// ("default") or an ArenaMemoryPool of arena_capacity bytes ("arena"). The
+// decoded table always comes from BenchmarkMemoryPool(). peak_rss_growth_mb is
+// the largest rise of the resident set over its value before the reads.
+struct ArenaResult {
+    int num_columns;
+    int num_rows;
+    std::string scratch_pool;
+    int64_t arena_capacity;
+    double read_time_ms;
+    double throughput_mb_s;
+    double peak_rss_growth_mb;
+    int64_t arena_allocations;
+    int64_t fallback_allocations;
+    int64_t rewinds;
+};
+
+// One data page read with the low-level PageReader. Decompression and decoding
+// are timed apart; the first page of a dictionary-encoded chunk also pays for
+// decoding the dictionary.
+struct PageTiming {
+    int64_t compressed_size;
+    int64_t uncompressed_size;
+    int32_t num_values;
+    double decompress_time_us;
+    double decode_time_us;
+};
+
+struct PageReadResult {
+    int num_columns;
+    int num_rows;
+    int64_t page_size;
+    int64_t num_pages;
+    int64_t compressed_bytes;
+    int64_t uncompressed_bytes;
+    double decompress_time_ms;
+    double decode_time_ms;
+    // Uncompressed MB per second of decompression and of decoding
+    double decompress_throughput_mb_s;
+    double decode_throughput_mb_s;
+    double decompress_p50_us;
+    double decompress_p99_us;
+    double decode_p50_us;
+    double decode_p99_us;
 };
 
 class DataReadBenchmark {
 public:
-    static arrow::Status GenerateParquetFile(int num_columns, int num_rows, const std::string& filename);
+    static arrow::Status GenerateParquetFile(int num_columns, int num_rows, const std::string& filename,
+                                             int64_t row_group_size = 10000,
+                                             std::shared_ptr<parquet::WriterProperties> properties =
+                                                 parquet::default_writer_properties());
     static double MeasureMetadataDecodeTime(const std::string& filename);
+    static double MeasureFlatbufferMetadataDecodeTime(const std::string& filename);
+    // Open time when the footer is already in MetadataCache::Global()
+    static double MeasureCachedMetadataDecodeTime(const std::string& filename);
     static double MeasureFullDataReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader);
     static double MeasureRandomColumnReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader, int num_columns);
+    // num_columns / 2 distinct random column indices in ascending order, as
+    // MeasureRandomColumnReadTime reads; the same for a given --seed
+    static std::vector<int> RandomColumnIndices(int num_columns);
+    static double MeasureColumnReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader,
+                                        const std::vector<int>& column_indices);
+    // Time to fetch and decompress every page of every column chunk
     static double MeasurePageReadTime(const std::unique_ptr<parquet::arrow::FileReader>& reader);
+    // Repeats the metadata decodes and the reads through `reader`, evicting
+    // `filename` from the page cache before each
+    static arrow::Status MeasureColdReadTimes(const std::string& filename,
+                                              const std::unique_ptr<parquet::arrow::FileReader>& reader,
+                                              BenchmarkResult* result);
     static arrow::Status RunBenchmark(int num_columns, int num_rows, const std::string& filename);
     static void WriteBenchmarkResults(const std::vector<BenchmarkResult>& results, const std::string& filename);
+    static void WriteAllocationResults(const std::vector<PhaseAllocationResult>& results, const std::string& filename);
+
+    // Best of several reads of `column_indices` (every column if empty) with a
+    // freshly opened reader, after resizing the CPU and I/O thread pools.
+    static double MeasureConfiguredReadTime(const std::string& filename, const parquet::ArrowReaderProperties& properties,
+                                            int cpu_threads, int io_threads, const std::vector<int>& column_indices);
+    // Sweeps use_threads, pre-buffering and the thread pool sizes from 1 to all
+    // cores for full and projected reads.
+    static arrow::Status RunThreadScalingBenchmark(int num_columns, int num_rows, const std::string& filename);
+    static void WriteThreadScalingResults(const std::vector<ThreadScalingResult>& results, const std::string& filename);
+
+    // Reads `column_indices` through a SimulatedStorageFile with `storage`, which
+    // counts the I/O calls; the footer read is not counted.
+    static CoalescingResult MeasureCoalescedColumnReadTime(const std::string& filename,
+                                                           const SimulatedStorageOptions& storage, bool pre_buffer,
+                                                           const arrow::io::CacheOptions& cache_options,
+                                                           const std::vector<int>& column_indices);
+    // Sweeps the CacheOptions hole and range size limits for random projected
+    // reads, on local files and on simulated high-latency storage.
+    static arrow::Status RunCoalescingBenchmark(int num_columns, int num_rows, const std::string& filename);
+    static void WriteCoalescingResults(const std::vector<CoalescingResult>& results, const std::string& filename);
+
+    // Best of several full reads with an arena of `arena_capacity` bytes as the
+    // Parquet reader's pool, or BenchmarkMemoryPool() if 0.
+    static ArenaResult MeasureScratchPoolRead(const std::string& filename, int64_t arena_capacity);
+    // Compares the default pool with arenas from 1 MB to 64 MB on a file with
+    // 1000-row row groups.
+    static arrow::Status RunArenaBenchmark(int num_columns, int num_rows, const std::string& filename);
+    static void WriteArenaResults(const std::vector<ArenaResult>& results, const std::string& filename);
+
+    // Walks every column chunk page by page. Supports DATA_PAGE pages of INT32,
+    // INT64, FLOAT and DOUBLE columns; throws parquet::ParquetException otherwise.
+    static std::vector<PageTiming> MeasurePageTimings(const std::string& filename);
+    // Page timings for files written with data page sizes from 8 KB to 8 MB,
+    // summarized per page size and as log2 latency histograms.
+    static arrow::Status RunPageSizeBenchmark(int num_columns, int num_rows, const std::string& filename_prefix);
+    static void WritePageReadResults(const std::vector<PageReadResult>& results, const std::string& filename);
+    static void WritePageLatencyHistograms(const std::vector<std::pair<int64_t, std::vector<PageTiming>>>& timings,
+                                           const std::string& filename);
 };
 
 #endif // DATA_READ_BENCHMARK_H
\ No newline at end of file
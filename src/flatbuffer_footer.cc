@@ -0,0 +1,235 @@
+#include "flatbuffer_footer.h"
+#include "benchmark_io.h"
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/properties.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+constexpr char kParquetMagic[] = "PAR1";
+
+uint32_t LoadUInt32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void AppendUInt32(uint32_t value, std::string* out) {
+    out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+std::string AppendFlatbufferExtension(std::string thrift_footer, const std::string& flatbuffer,
+                                      int64_t footer_offset) {
+    auto uleb_size = [](uint64_t x) {
+        int size = 1;
+        while (x >>= 7) {
+            ++size;
+        }
+        return size;
+    };
+    auto append_uleb = [](uint64_t x, std::string* out) {
+        while (true) {
+            int c = x & 0x7F;
+            if ((x >>= 7) == 0) {
+                out->push_back(c);
+                return;
+            } else {
+                out->push_back(c | 0x80);
+            }
+        }
+    };
+    // Compact-protocol header of a binary field whose id no Parquet reader knows,
+    // so existing readers skip over the payload.
+    const std::string field_header("\x08\xFF\xFF\x01", 4);
+
+    thrift_footer.pop_back();  // remove the trailing 0
+
+    int64_t padding = 0;
+    int64_t payload_size = 0;
+    for (;; ++padding) {
+        payload_size = padding + flatbuffer.size() + kFlatbufferExtensionTrailerSize;
+        int64_t flatbuffer_offset = footer_offset + thrift_footer.size() + field_header.size() +
+                                    uleb_size(payload_size) + padding;
+        if (flatbuffer_offset % 8 == 0) {
+            break;
+        }
+    }
+
+    thrift_footer += field_header;
+    append_uleb(payload_size, &thrift_footer);
+    thrift_footer.append(padding, '\0');
+    thrift_footer += flatbuffer;
+    AppendUInt32(static_cast<uint32_t>(flatbuffer.size()), &thrift_footer);
+    thrift_footer.append(kFlatbufferExtensionMagic, 4);
+    thrift_footer.push_back('\0');  // add the trailing 0 back
+    return thrift_footer;
+}
+
+bool FindFlatbufferExtension(const uint8_t* footer, int64_t footer_len,
+                             const uint8_t** flatbuffer, int64_t* flatbuffer_len) {
+    // The extension is the last field of the struct, so its trailer sits right
+    // before the struct's stop byte.
+    if (footer_len < kFlatbufferExtensionTrailerSize + 1 || footer[footer_len - 1] != 0) {
+        return false;
+    }
+    const uint8_t* trailer = footer + footer_len - 1 - kFlatbufferExtensionTrailerSize;
+    if (std::memcmp(trailer + 4, kFlatbufferExtensionMagic, 4) != 0) {
+        return false;
+    }
+    uint32_t size = LoadUInt32(trailer);
+    if (size > trailer - footer) {
+        return false;
+    }
+    *flatbuffer = trailer - size;
+    *flatbuffer_len = size;
+    return true;
+}
+
+namespace {
+
+// Reads the footer of `file` and returns it with the FlatBuffer extension added,
+// followed by the new footer length and magic.
+arrow::Result<std::string> BuildExtendedFooter(arrow::io::RandomAccessFile* file, int64_t* footer_start) {
+    uint32_t footer_len;
+    ARROW_RETURN_NOT_OK(ReadFooterLocation(file, footer_start, &footer_len));
+    ARROW_ASSIGN_OR_RAISE(auto footer, file->ReadAt(*footer_start, footer_len));
+
+    const uint8_t* flatbuffer;
+    int64_t flatbuffer_len;
+    if (FindFlatbufferExtension(footer->data(), footer->size(), &flatbuffer, &flatbuffer_len)) {
+        return arrow::Status::AlreadyExists("Footer already carries a FlatBuffer extension");
+    }
+
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    uint32_t metadata_len = footer_len;
+    PARQUET_CATCH_NOT_OK(metadata = parquet::FileMetaData::Make(footer->data(), &metadata_len));
+    std::string extended_footer = AppendFlatbufferExtension(footer->ToString(), ConvertToFlatbuffer(*metadata),
+                                                            *footer_start);
+    AppendUInt32(static_cast<uint32_t>(extended_footer.size()), &extended_footer);
+    extended_footer.append(kParquetMagic, 4);
+    return extended_footer;
+}
+
+}  // namespace
+
+arrow::Status RewriteWithFlatbufferFooter(const std::string& input_filename, const std::string& output_filename) {
+    std::shared_ptr<arrow::io::ReadableFile> infile;
+    ARROW_ASSIGN_OR_RAISE(infile, arrow::io::ReadableFile::Open(input_filename));
+
+    int64_t footer_start;
+    ARROW_ASSIGN_OR_RAISE(auto extended_footer, BuildExtendedFooter(infile.get(), &footer_start));
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(output_filename));
+
+    // Column chunks are copied unchanged; only the footer grows.
+    constexpr int64_t kCopyChunkSize = 8 * 1024 * 1024;
+    for (int64_t offset = 0; offset < footer_start; offset += kCopyChunkSize) {
+        ARROW_ASSIGN_OR_RAISE(auto chunk, infile->ReadAt(offset, std::min(kCopyChunkSize, footer_start - offset)));
+        ARROW_RETURN_NOT_OK(outfile->Write(chunk));
+    }
+    ARROW_RETURN_NOT_OK(outfile->Write(extended_footer.data(), extended_footer.size()));
+    return outfile->Close();
+}
+
+arrow::Status EmbedFlatbufferFooter(const std::string& filename) {
+    int64_t footer_start;
+    std::string extended_footer;
+    {
+        std::shared_ptr<arrow::io::ReadableFile> infile;
+        ARROW_ASSIGN_OR_RAISE(infile, arrow::io::ReadableFile::Open(filename));
+        ARROW_ASSIGN_OR_RAISE(extended_footer, BuildExtendedFooter(infile.get(), &footer_start));
+        ARROW_RETURN_NOT_OK(infile->Close());
+    }
+
+    // Drop the old footer and write the extended one in its place.
+    std::error_code ec;
+    std::filesystem::resize_file(filename, footer_start, ec);
+    if (ec) {
+        return arrow::Status::IOError("Failed to truncate ", filename, ": ", ec.message());
+    }
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename, /*append=*/true));
+    ARROW_RETURN_NOT_OK(outfile->Write(extended_footer.data(), extended_footer.size()));
+    return outfile->Close();
+}
+
+arrow::Status WriteTableWithFlatbufferFooter(const arrow::Table& table, arrow::MemoryPool* pool,
+                                             const std::string& filename, int64_t chunk_size,
+                                             std::shared_ptr<parquet::WriterProperties> properties) {
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filename));
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(table, pool, outfile, chunk_size, properties));
+    ARROW_RETURN_NOT_OK(outfile->Close());
+    return EmbedFlatbufferFooter(filename);
+}
+
+FlatbufferFooter::FlatbufferFooter(std::shared_ptr<arrow::Buffer> footer, const parquet2::FileMetaData* metadata,
+                                   int64_t flatbuffer_size)
+    : footer_(std::move(footer)), metadata_(metadata), flatbuffer_size_(flatbuffer_size), num_columns_(0) {
+    if (metadata_->schema()) {
+        // Element 0 is the schema root; every element without children is a leaf.
+        for (flatbuffers::uoffset_t i = 1; i < metadata_->schema()->size(); ++i) {
+            if (metadata_->schema()->Get(i)->num_children() == 0) {
+                ++num_columns_;
+            }
+        }
+    }
+}
+
+arrow::Result<std::shared_ptr<FlatbufferFooter>> FlatbufferFooter::Open(
+    std::shared_ptr<arrow::io::RandomAccessFile> file, bool verify) {
+    int64_t footer_start;
+    uint32_t footer_len;
+    ARROW_RETURN_NOT_OK(ReadFooterLocation(file.get(), &footer_start, &footer_len));
+
+    // Start the read on an 8-byte boundary so the FlatBuffer, which the writer
+    // aligned within the file, is also aligned in memory.
+    int64_t read_start = footer_start & ~int64_t{7};
+    std::shared_ptr<arrow::Buffer> footer;
+    ARROW_ASSIGN_OR_RAISE(footer, file->ReadAt(read_start, footer_start + footer_len - read_start));
+
+    const uint8_t* flatbuffer;
+    int64_t flatbuffer_len;
+    if (!FindFlatbufferExtension(footer->data() + (footer_start - read_start), footer_len,
+                                 &flatbuffer, &flatbuffer_len)) {
+        return arrow::Status::Invalid("Parquet footer carries no FlatBuffer extension");
+    }
+    if (reinterpret_cast<uintptr_t>(flatbuffer) % 8 != 0) {
+        ARROW_ASSIGN_OR_RAISE(auto aligned, arrow::AllocateBuffer(flatbuffer_len));
+        std::memcpy(aligned->mutable_data(), flatbuffer, flatbuffer_len);
+        footer = std::move(aligned);
+        flatbuffer = footer->data();
+    }
+    if (verify) {
+        flatbuffers::Verifier verifier(flatbuffer, flatbuffer_len);
+        if (!parquet2::VerifyFileMetaDataBuffer(verifier)) {
+            return arrow::Status::Invalid("FlatBuffer footer failed verification");
+        }
+    }
+    return std::shared_ptr<FlatbufferFooter>(
+        new FlatbufferFooter(std::move(footer), parquet2::GetFileMetaData(flatbuffer), flatbuffer_len));
+}
+
+std::shared_ptr<parquet::FileMetaData> FlatbufferFooter::ToFileMetaData(const std::vector<int>& column_indices) const {
+    return ConvertFromFlatbuffer(*metadata_, column_indices);
+}
+
+arrow::Status OpenFileWithFlatbufferFooter(std::shared_ptr<arrow::io::RandomAccessFile> file, arrow::MemoryPool* pool,
+                                           const std::vector<int>& column_indices,
+                                           std::unique_ptr<parquet::arrow::FileReader>* reader) {
+    std::shared_ptr<FlatbufferFooter> footer;
+    ARROW_ASSIGN_OR_RAISE(footer, FlatbufferFooter::Open(file));
+
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader;
+    PARQUET_CATCH_NOT_OK(parquet_reader = parquet::ParquetFileReader::Open(
+        file, parquet::ReaderProperties(pool), footer->ToFileMetaData(column_indices)));
+    return parquet::arrow::FileReader::Make(pool, std::move(parquet_reader), reader);
+}
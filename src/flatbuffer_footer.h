@@ -0,0 +1,84 @@
+#ifndef FLATBUFFER_FOOTER_H
+#define FLATBUFFER_FOOTER_H
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/metadata.h>
+#include <parquet/properties.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flatbuff_ns_generated.h"
+#include "footer_codec.h"
+
+// The parquet2 FlatBuffer travels inside the Thrift footer as a binary field that
+// Thrift readers skip. Its payload is laid out as
+//
+//   [zero padding][flatbuffer][uint32 flatbuffer size]["FBUF"]
+//
+// so that a reader can locate it from the end of the footer without decoding any
+// Thrift, and the padding keeps the FlatBuffer 8-byte aligned in the file.
+constexpr char kFlatbufferExtensionMagic[] = "FBUF";
+constexpr int kFlatbufferExtensionTrailerSize = 8;
+
+// Adds `flatbuffer` to a serialized Thrift FileMetaData as an extension field.
+// `footer_offset` is the file offset at which the footer will be written.
+std::string AppendFlatbufferExtension(std::string thrift_footer, const std::string& flatbuffer,
+                                      int64_t footer_offset = 0);
+
+// Locates the FlatBuffer embedded by AppendFlatbufferExtension. Returns false if
+// the footer carries no extension.
+bool FindFlatbufferExtension(const uint8_t* footer, int64_t footer_len,
+                             const uint8_t** flatbuffer, int64_t* flatbuffer_len);
+
+// Copies a Parquet file, adding the FlatBuffer extension to its footer. Returns
+// AlreadyExists if the input footer already carries one.
+arrow::Status RewriteWithFlatbufferFooter(const std::string& input_filename, const std::string& output_filename);
+
+// Adds the FlatBuffer extension to the footer of `filename` in place. Only the
+// footer is rewritten; column chunk offsets are unchanged.
+arrow::Status EmbedFlatbufferFooter(const std::string& filename);
+
+// parquet::arrow::WriteTable followed by EmbedFlatbufferFooter.
+arrow::Status WriteTableWithFlatbufferFooter(
+    const arrow::Table& table, arrow::MemoryPool* pool, const std::string& filename, int64_t chunk_size,
+    std::shared_ptr<parquet::WriterProperties> properties = parquet::default_writer_properties());
+
+class FlatbufferFooter {
+public:
+    // Reads the footer of `file` and maps the embedded FlatBuffer in place. With a
+    // MemoryMappedFile no bytes are copied.
+    static arrow::Result<std::shared_ptr<FlatbufferFooter>> Open(std::shared_ptr<arrow::io::RandomAccessFile> file,
+                                                                 bool verify = false);
+
+    const parquet2::FileMetaData* metadata() const { return metadata_; }
+    int64_t flatbuffer_size() const { return flatbuffer_size_; }
+    int num_columns() const { return num_columns_; }
+    // Leaf column index of the column with dot path `name`, or -1. See FindColumnIndex.
+    int FindColumn(std::string_view name) const { return FindColumnIndex(*metadata_, name); }
+
+    // Builds the metadata parquet::ParquetFileReader needs straight from the
+    // FlatBuffer. When `column_indices` is non-empty, the schema and row groups
+    // only describe those leaf columns, in file order.
+    std::shared_ptr<parquet::FileMetaData> ToFileMetaData(const std::vector<int>& column_indices = {}) const;
+
+private:
+    FlatbufferFooter(std::shared_ptr<arrow::Buffer> footer, const parquet2::FileMetaData* metadata,
+                     int64_t flatbuffer_size);
+
+    std::shared_ptr<arrow::Buffer> footer_;
+    const parquet2::FileMetaData* metadata_;
+    int64_t flatbuffer_size_;
+    int num_columns_;
+};
+
+// Opens a parquet::arrow::FileReader whose metadata comes from the FlatBuffer
+// extension, so opening the file performs no Thrift decode. The Arrow arrays
+// and the page buffers are both allocated from `pool`.
+arrow::Status OpenFileWithFlatbufferFooter(std::shared_ptr<arrow::io::RandomAccessFile> file, arrow::MemoryPool* pool,
+                                           const std::vector<int>& column_indices,
+                                           std::unique_ptr<parquet::arrow::FileReader>* reader);
+
+#endif  // FLATBUFFER_FOOTER_H
@@ -0,0 +1,96 @@
+#include "flatbuffer_footer.h"
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Adds the FlatBuffer footer extension to existing Parquet files.
+//
+//   flatbuffer_footer_rewrite <input> <output>
+//       Copies one file, or every .parquet file under a directory into an output
+//       directory with the same layout.
+//   flatbuffer_footer_rewrite --in-place <path>...
+//       Rewrites only the footer of each file, or of every .parquet file under
+//       each directory.
+//
+// Files whose footer already carries the extension are skipped.
+
+namespace {
+
+std::vector<fs::path> FindParquetFiles(const fs::path& path) {
+    std::vector<fs::path> files;
+    if (!fs::is_directory(path)) {
+        files.push_back(path);
+        return files;
+    }
+    for (const auto& entry : fs::recursive_directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".parquet") {
+            files.push_back(entry.path());
+        }
+    }
+    return files;
+}
+
+struct ConversionStats {
+    int converted = 0;
+    int skipped = 0;
+    int failed = 0;
+};
+
+void Report(const fs::path& file, const arrow::Status& status, ConversionStats* stats) {
+    if (status.ok()) {
+        ++stats->converted;
+        std::cout << "Converted " << file << std::endl;
+    } else if (status.IsAlreadyExists()) {
+        ++stats->skipped;
+        std::cout << "Skipped " << file << ": " << status.message() << std::endl;
+    } else {
+        ++stats->failed;
+        std::cerr << "Failed " << file << ": " << status.ToString() << std::endl;
+    }
+}
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <input file or directory> <output file or directory>\n"
+              << "       " << program << " --in-place <file or directory>..." << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    ConversionStats stats;
+    if (std::string(argv[1]) == "--in-place") {
+        for (int i = 2; i < argc; ++i) {
+            for (const auto& file : FindParquetFiles(argv[i])) {
+                Report(file, EmbedFlatbufferFooter(file.string()), &stats);
+            }
+        }
+    } else if (argc == 3) {
+        fs::path input(argv[1]);
+        fs::path output(argv[2]);
+        if (fs::is_directory(input)) {
+            for (const auto& file : FindParquetFiles(input)) {
+                fs::path target = output / fs::relative(file, input);
+                std::error_code ec;
+                fs::create_directories(target.parent_path(), ec);
+                Report(file, RewriteWithFlatbufferFooter(file.string(), target.string()), &stats);
+            }
+        } else {
+            Report(input, RewriteWithFlatbufferFooter(input.string(), output.string()), &stats);
+        }
+    } else {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << stats.converted << " converted, " << stats.skipped << " skipped, "
+              << stats.failed << " failed" << std::endl;
+    return stats.failed == 0 ? 0 : 1;
+}
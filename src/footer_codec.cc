@@ -0,0 +1,876 @@
+#include "footer_codec.h"
+#include <arrow/util/key_value_metadata.h>
+#include <parquet/exception.h>
+#include <parquet/page_index.h>
+#include <parquet/properties.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace {
+
+parquet2::CompressionCodec ToFlatbuffer(parquet::Compression::type codec) {
+    // Arrow's enum does not follow the Thrift numbering, so map each codec explicitly.
+    switch (codec) {
+        case parquet::Compression::SNAPPY: return parquet2::CompressionCodec_SNAPPY;
+        case parquet::Compression::GZIP: return parquet2::CompressionCodec_GZIP;
+        case parquet::Compression::LZO: return parquet2::CompressionCodec_LZO;
+        case parquet::Compression::BROTLI: return parquet2::CompressionCodec_BROTLI;
+        case parquet::Compression::LZ4_HADOOP: return parquet2::CompressionCodec_LZ4;
+        case parquet::Compression::ZSTD: return parquet2::CompressionCodec_ZSTD;
+        case parquet::Compression::LZ4: return parquet2::CompressionCodec_LZ4_RAW;
+        default: return parquet2::CompressionCodec_UNCOMPRESSED;
+    }
+}
+
+parquet::Compression::type FromFlatbuffer(parquet2::CompressionCodec codec) {
+    switch (codec) {
+        case parquet2::CompressionCodec_SNAPPY: return parquet::Compression::SNAPPY;
+        case parquet2::CompressionCodec_GZIP: return parquet::Compression::GZIP;
+        case parquet2::CompressionCodec_LZO: return parquet::Compression::LZO;
+        case parquet2::CompressionCodec_BROTLI: return parquet::Compression::BROTLI;
+        case parquet2::CompressionCodec_LZ4: return parquet::Compression::LZ4_HADOOP;
+        case parquet2::CompressionCodec_ZSTD: return parquet::Compression::ZSTD;
+        case parquet2::CompressionCodec_LZ4_RAW: return parquet::Compression::LZ4;
+        default: return parquet::Compression::UNCOMPRESSED;
+    }
+}
+
+// parquet2 follows the Thrift numbering, which starts at UTF8 rather than NONE.
+parquet2::ConvertedType ToFlatbuffer(parquet::ConvertedType::type converted_type) {
+    if (converted_type == parquet::ConvertedType::NONE || converted_type >= parquet::ConvertedType::NA) {
+        return parquet2::ConvertedType_UNSET;
+    }
+    return static_cast<parquet2::ConvertedType>(converted_type - 1);
+}
+
+parquet::ConvertedType::type FromFlatbuffer(parquet2::ConvertedType converted_type) {
+    if (converted_type == parquet2::ConvertedType_UNSET) {
+        return parquet::ConvertedType::NONE;
+    }
+    return static_cast<parquet::ConvertedType::type>(converted_type + 1);
+}
+
+std::pair<parquet2::TimeUnit, flatbuffers::Offset<void>> ToFlatbuffer(parquet::LogicalType::TimeUnit::unit unit,
+                                                                      flatbuffers::FlatBufferBuilder& builder) {
+    switch (unit) {
+        case parquet::LogicalType::TimeUnit::NANOS:
+            return {parquet2::TimeUnit_NanoSeconds, parquet2::CreateNanoSeconds(builder).Union()};
+        case parquet::LogicalType::TimeUnit::MICROS:
+            return {parquet2::TimeUnit_MicroSeconds, parquet2::CreateMicroSeconds(builder).Union()};
+        default:
+            return {parquet2::TimeUnit_MilliSeconds, parquet2::CreateMilliSeconds(builder).Union()};
+    }
+}
+
+parquet::LogicalType::TimeUnit::unit FromFlatbuffer(parquet2::TimeUnit unit) {
+    switch (unit) {
+        case parquet2::TimeUnit_NanoSeconds: return parquet::LogicalType::TimeUnit::NANOS;
+        case parquet2::TimeUnit_MicroSeconds: return parquet::LogicalType::TimeUnit::MICROS;
+        default: return parquet::LogicalType::TimeUnit::MILLIS;
+    }
+}
+
+// Logical types without a parquet2 counterpart (INTERVAL, FLOAT16) are carried by
+// their converted type only.
+std::pair<parquet2::LogicalType, flatbuffers::Offset<void>> ToFlatbuffer(const parquet::LogicalType& type,
+                                                                         flatbuffers::FlatBufferBuilder& builder) {
+    switch (type.type()) {
+        case parquet::LogicalType::Type::STRING:
+            return {parquet2::LogicalType_StringType, parquet2::CreateStringType(builder).Union()};
+        case parquet::LogicalType::Type::MAP:
+            return {parquet2::LogicalType_MapType, parquet2::CreateMapType(builder).Union()};
+        case parquet::LogicalType::Type::LIST:
+            return {parquet2::LogicalType_ListType, parquet2::CreateListType(builder).Union()};
+        case parquet::LogicalType::Type::ENUM:
+            return {parquet2::LogicalType_EnumType, parquet2::CreateEnumType(builder).Union()};
+        case parquet::LogicalType::Type::DECIMAL: {
+            const auto& decimal = static_cast<const parquet::DecimalLogicalType&>(type);
+            return {parquet2::LogicalType_DecimalType,
+                    parquet2::CreateDecimalType(builder, decimal.precision(), decimal.scale()).Union()};
+        }
+        case parquet::LogicalType::Type::DATE:
+            return {parquet2::LogicalType_DateType, parquet2::CreateDateType(builder).Union()};
+        case parquet::LogicalType::Type::TIME: {
+            const auto& time = static_cast<const parquet::TimeLogicalType&>(type);
+            auto unit = ToFlatbuffer(time.time_unit(), builder);
+            return {parquet2::LogicalType_TimeType,
+                    parquet2::CreateTimeType(builder, time.is_adjusted_to_utc(), unit.first, unit.second).Union()};
+        }
+        case parquet::LogicalType::Type::TIMESTAMP: {
+            const auto& timestamp = static_cast<const parquet::TimestampLogicalType&>(type);
+            auto unit = ToFlatbuffer(timestamp.time_unit(), builder);
+            return {parquet2::LogicalType_TimestampType,
+                    parquet2::CreateTimestampType(builder, timestamp.is_adjusted_to_utc(), unit.first, unit.second)
+                        .Union()};
+        }
+        case parquet::LogicalType::Type::INT: {
+            const auto& integer = static_cast<const parquet::IntLogicalType&>(type);
+            return {parquet2::LogicalType_IntType,
+                    parquet2::CreateIntType(builder, static_cast<int8_t>(integer.bit_width()), integer.is_signed())
+                        .Union()};
+        }
+        case parquet::LogicalType::Type::NIL:
+            return {parquet2::LogicalType_NullType, parquet2::CreateNullType(builder).Union()};
+        case parquet::LogicalType::Type::JSON:
+            return {parquet2::LogicalType_JsonType, parquet2::CreateJsonType(builder).Union()};
+        case parquet::LogicalType::Type::BSON:
+            return {parquet2::LogicalType_BsonType, parquet2::CreateBsonType(builder).Union()};
+        case parquet::LogicalType::Type::UUID:
+            return {parquet2::LogicalType_UUIDType, parquet2::CreateUUIDType(builder).Union()};
+        default:
+            return {parquet2::LogicalType_NONE, 0};
+    }
+}
+
+std::shared_ptr<const parquet::LogicalType> FromFlatbuffer(const parquet2::SchemaElement& element) {
+    switch (element.logical_type_type()) {
+        case parquet2::LogicalType_StringType: return parquet::LogicalType::String();
+        case parquet2::LogicalType_MapType: return parquet::LogicalType::Map();
+        case parquet2::LogicalType_ListType: return parquet::LogicalType::List();
+        case parquet2::LogicalType_EnumType: return parquet::LogicalType::Enum();
+        case parquet2::LogicalType_DecimalType: {
+            const auto* decimal = element.logical_type_as_DecimalType();
+            return parquet::LogicalType::Decimal(decimal->precision(), decimal->scale());
+        }
+        case parquet2::LogicalType_DateType: return parquet::LogicalType::Date();
+        case parquet2::LogicalType_TimeType: {
+            const auto* time = element.logical_type_as_TimeType();
+            return parquet::LogicalType::Time(time->is_adjusted_to_utc(), FromFlatbuffer(time->unit_type()));
+        }
+        case parquet2::LogicalType_TimestampType: {
+            const auto* timestamp = element.logical_type_as_TimestampType();
+            return parquet::LogicalType::Timestamp(timestamp->is_adjusted_to_utc(),
+                                                   FromFlatbuffer(timestamp->unit_type()));
+        }
+        case parquet2::LogicalType_IntType: {
+            const auto* integer = element.logical_type_as_IntType();
+            return parquet::LogicalType::Int(integer->bit_width(), integer->is_signed());
+        }
+        case parquet2::LogicalType_NullType: return parquet::LogicalType::Null();
+        case parquet2::LogicalType_JsonType: return parquet::LogicalType::JSON();
+        case parquet2::LogicalType_BsonType: return parquet::LogicalType::BSON();
+        case parquet2::LogicalType_UUIDType: return parquet::LogicalType::UUID();
+        default: return nullptr;
+    }
+}
+
+// Byte width of plain-encoded min/max values that fit in min8/max8, or 0.
+size_t InlineStatisticsWidth(parquet::Type::type type) {
+    switch (type) {
+        case parquet::Type::BOOLEAN: return 1;
+        case parquet::Type::INT32:
+        case parquet::Type::FLOAT: return 4;
+        case parquet::Type::INT64:
+        case parquet::Type::DOUBLE: return 8;
+        default: return 0;
+    }
+}
+
+int64_t LoadInline(const std::string& value) {
+    int64_t result = 0;
+    std::memcpy(&result, value.data(), value.size());
+    return result;
+}
+
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> ToBinary(const std::string& value,
+                                                          flatbuffers::FlatBufferBuilder& builder) {
+    return builder.CreateVector(reinterpret_cast<const int8_t*>(value.data()), value.size());
+}
+
+flatbuffers::Offset<parquet2::Statistics> ConvertStatistics(const parquet::EncodedStatistics& statistics,
+                                                            parquet::Type::type type,
+                                                            const FooterCodecOptions& options,
+                                                            flatbuffers::FlatBufferBuilder& builder) {
+    size_t width = options.optimize_statistics ? InlineStatisticsWidth(type) : 0;
+    bool inline_min = statistics.has_min && width > 0 && statistics.min().size() == width;
+    bool inline_max = statistics.has_max && width > 0 && statistics.max().size() == width;
+
+    flatbuffers::Offset<flatbuffers::Vector<int8_t>> min_value;
+    flatbuffers::Offset<flatbuffers::Vector<int8_t>> max_value;
+    if (statistics.has_min && !inline_min) {
+        min_value = ToBinary(statistics.min(), builder);
+    }
+    if (statistics.has_max && !inline_max) {
+        max_value = ToBinary(statistics.max(), builder);
+    }
+
+    parquet2::StatisticsBuilder result(builder);
+    if (statistics.has_null_count) {
+        result.add_null_count(statistics.null_count);
+    }
+    if (statistics.has_distinct_count) {
+        result.add_distinct_count(statistics.distinct_count);
+    }
+    if (!max_value.IsNull()) {
+        result.add_max_value(max_value);
+    }
+    if (!min_value.IsNull()) {
+        result.add_min_value(min_value);
+    }
+    if (inline_max) {
+        result.add_max8(LoadInline(statistics.max()));
+    }
+    if (inline_min) {
+        result.add_min8(LoadInline(statistics.min()));
+    }
+    return result.Finish();
+}
+
+parquet::EncodedStatistics FromFlatbuffer(const parquet2::Statistics& statistics, parquet::Type::type type) {
+    auto load = [&](const flatbuffers::Vector<int8_t>* value, flatbuffers::Optional<int64_t> value8) {
+        if (value) {
+            return std::string(reinterpret_cast<const char*>(value->data()), value->size());
+        }
+        int64_t inline_value = *value8;
+        return std::string(reinterpret_cast<const char*>(&inline_value), InlineStatisticsWidth(type));
+    };
+
+    parquet::EncodedStatistics result;
+    if (statistics.null_count().has_value()) {
+        result.set_null_count(statistics.null_count().value());
+    }
+    if (statistics.distinct_count() > 0) {
+        result.set_distinct_count(statistics.distinct_count());
+    }
+    if (statistics.min_value() || statistics.min8().has_value()) {
+        result.set_min(load(statistics.min_value(), statistics.min8()));
+    }
+    if (statistics.max_value() || statistics.max8().has_value()) {
+        result.set_max(load(statistics.max_value(), statistics.max8()));
+    }
+    return result;
+}
+
+// Emits the schema depth-first, the same flattening the Thrift footer uses, and
+// records the element index of every leaf.
+void ConvertSchemaNode(const parquet::schema::Node& node, flatbuffers::FlatBufferBuilder& builder,
+                       std::vector<flatbuffers::Offset<parquet2::SchemaElement>>* elements,
+                       std::vector<int32_t>* leaf_elements) {
+    auto name = builder.CreateSharedString(node.name());
+    std::pair<parquet2::LogicalType, flatbuffers::Offset<void>> logical_type{parquet2::LogicalType_NONE, 0};
+    if (node.logical_type()) {
+        logical_type = ToFlatbuffer(*node.logical_type(), builder);
+    }
+
+    parquet2::SchemaElementBuilder element(builder);
+    if (node.is_primitive()) {
+        const auto& primitive = static_cast<const parquet::schema::PrimitiveNode&>(node);
+        element.add_type(static_cast<parquet2::Type>(primitive.physical_type()));
+        if (primitive.physical_type() == parquet::Type::FIXED_LEN_BYTE_ARRAY) {
+            element.add_type_length(primitive.type_length());
+        }
+        if (primitive.decimal_metadata().isset) {
+            element.add_scale(primitive.decimal_metadata().scale);
+            element.add_precision(primitive.decimal_metadata().precision);
+        }
+        leaf_elements->push_back(static_cast<int32_t>(elements->size()));
+    } else {
+        element.add_num_children(static_cast<const parquet::schema::GroupNode&>(node).field_count());
+    }
+    element.add_repetition_type(static_cast<parquet2::FieldRepetitionType>(node.repetition()));
+    element.add_name(name);
+    if (node.converted_type() != parquet::ConvertedType::NONE) {
+        element.add_converted_type(ToFlatbuffer(node.converted_type()));
+    }
+    if (node.field_id() >= 0) {
+        element.add_field_id(node.field_id());
+    }
+    if (logical_type.first != parquet2::LogicalType_NONE) {
+        element.add_logical_type_type(logical_type.first);
+        element.add_logical_type(logical_type.second);
+    }
+    elements->push_back(element.Finish());
+
+    if (node.is_group()) {
+        const auto& group = static_cast<const parquet::schema::GroupNode&>(node);
+        for (int i = 0; i < group.field_count(); ++i) {
+            ConvertSchemaNode(*group.field(i), builder, elements, leaf_elements);
+        }
+    }
+}
+
+flatbuffers::Offset<parquet2::ColumnMetadata> ConvertColumnMetadata(const parquet::ColumnChunkMetaData& column,
+                                                                    int32_t schema_index,
+                                                                    const FooterCodecOptions& options,
+                                                                    flatbuffers::FlatBufferBuilder& builder) {
+    std::vector<int8_t> encodings;
+    for (auto encoding : column.encodings()) {
+        encodings.push_back(static_cast<int8_t>(encoding));
+    }
+    auto encodings_offset = builder.CreateVector(encodings);
+
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> path_in_schema;
+    if (!options.optimize_path_in_schema) {
+        std::vector<flatbuffers::Offset<flatbuffers::String>> path;
+        for (const auto& part : column.path_in_schema()->ToDotVector()) {
+            path.push_back(builder.CreateSharedString(part));
+        }
+        path_in_schema = builder.CreateVector(path);
+    }
+
+    // The reader rebuilds the chunk's encodings from these stats.
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<parquet2::PageEncodingStats>>> encoding_stats;
+    bool is_fully_dict_encoded = !column.encoding_stats().empty();
+    if (options.optimize_encodings) {
+        for (const auto& stats : column.encoding_stats()) {
+            if (stats.page_type == parquet::PageType::DATA_PAGE || stats.page_type == parquet::PageType::DATA_PAGE_V2) {
+                is_fully_dict_encoded &= stats.encoding == parquet::Encoding::PLAIN_DICTIONARY ||
+                                         stats.encoding == parquet::Encoding::RLE_DICTIONARY;
+            }
+        }
+    } else {
+        std::vector<flatbuffers::Offset<parquet2::PageEncodingStats>> stats_offsets;
+        for (const auto& stats : column.encoding_stats()) {
+            stats_offsets.push_back(parquet2::CreatePageEncodingStats(
+                builder,
+                static_cast<parquet2::PageType>(stats.page_type),
+                static_cast<parquet2::Encoding>(stats.encoding),
+                stats.count));
+        }
+        encoding_stats = builder.CreateVector(stats_offsets);
+    }
+
+    flatbuffers::Offset<parquet2::Statistics> statistics;
+    if (column.is_stats_set()) {
+        if (auto encoded = column.encoded_statistics()) {
+            statistics = ConvertStatistics(*encoded, column.type(), options, builder);
+        }
+    }
+
+    parquet2::ColumnMetadataBuilder metadata(builder);
+    if (!options.optimize_path_in_schema) {
+        metadata.add_type(static_cast<parquet2::Type>(column.type()));
+        metadata.add_path_in_schema(path_in_schema);
+    } else {
+        metadata.add_schema_index(schema_index);
+    }
+    metadata.add_encodings(encodings_offset);
+    if (!options.column_chunk_vectors) {
+        metadata.add_codec(ToFlatbuffer(column.compression()));
+        metadata.add_num_values(column.num_values());
+        metadata.add_total_uncompressed_size(column.total_uncompressed_size());
+        metadata.add_total_compressed_size(column.total_compressed_size());
+        metadata.add_data_page_offset(column.data_page_offset());
+        if (column.has_dictionary_page()) {
+            metadata.add_dictionary_page_offset(column.dictionary_page_offset());
+        }
+    }
+    if (column.has_index_page()) {
+        metadata.add_index_page_offset(column.index_page_offset());
+    }
+    if (!statistics.IsNull()) {
+        metadata.add_statistics(statistics);
+    }
+    if (options.optimize_encodings) {
+        metadata.add_is_fully_dict_encoded(is_fully_dict_encoded);
+    } else {
+        metadata.add_encoding_stats(encoding_stats);
+    }
+    if (auto bloom_filter_offset = column.bloom_filter_offset()) {
+        metadata.add_bloom_filter_offset(*bloom_filter_offset);
+    }
+    return metadata.Finish();
+}
+
+flatbuffers::Offset<parquet2::RowGroup> ConvertRowGroup(const parquet::RowGroupMetaData& row_group,
+                                                        const std::vector<int32_t>& leaf_elements,
+                                                        const FooterCodecOptions& options,
+                                                        flatbuffers::FlatBufferBuilder& builder) {
+    std::vector<flatbuffers::Offset<parquet2::ColumnChunk>> columns;
+    columns.reserve(row_group.num_columns());
+    for (int i = 0; i < row_group.num_columns(); ++i) {
+        auto column = row_group.ColumnChunk(i);
+        flatbuffers::Offset<flatbuffers::String> file_path;
+        if (!column->file_path().empty()) {
+            file_path = builder.CreateString(column->file_path());
+        }
+        auto metadata = ConvertColumnMetadata(*column, leaf_elements[i], options, builder);
+        auto column_index = column->GetColumnIndexLocation();
+        auto offset_index = column->GetOffsetIndexLocation();
+
+        parquet2::ColumnChunkBuilder chunk(builder);
+        if (!file_path.IsNull()) {
+            chunk.add_file_path(file_path);
+        }
+        chunk.add_file_offset(column->file_offset());
+        chunk.add_meta_data(metadata);
+        if (offset_index) {
+            chunk.add_offset_index_offset(offset_index->offset);
+            chunk.add_offset_index_length(offset_index->length);
+        }
+        if (column_index) {
+            chunk.add_column_index_offset(column_index->offset);
+            chunk.add_column_index_length(column_index->length);
+        }
+        columns.push_back(chunk.Finish());
+    }
+    auto columns_offset = builder.CreateVector(columns);
+
+    std::vector<flatbuffers::Offset<parquet2::SortingColumn>> sorting_columns;
+    for (const auto& sorting_column : row_group.sorting_columns()) {
+        sorting_columns.push_back(parquet2::CreateSortingColumn(
+            builder, sorting_column.column_idx, sorting_column.descending, sorting_column.nulls_first));
+    }
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<parquet2::SortingColumn>>> sorting_columns_offset;
+    if (!sorting_columns.empty()) {
+        sorting_columns_offset = builder.CreateVector(sorting_columns);
+    }
+
+    parquet2::RowGroupBuilder result(builder);
+    result.add_columns(columns_offset);
+    result.add_total_byte_size(row_group.total_byte_size());
+    result.add_num_rows(row_group.num_rows());
+    if (!sorting_columns_offset.IsNull()) {
+        result.add_sorting_columns(sorting_columns_offset);
+    }
+    result.add_file_offset(row_group.file_offset());
+    result.add_total_compressed_size(row_group.total_compressed_size());
+    return result.Finish();
+}
+
+flatbuffers::Offset<parquet2::ColumnChunkVectors> ConvertColumnChunkVectors(const parquet::FileMetaData& metadata,
+                                                                            flatbuffers::FlatBufferBuilder& builder) {
+    size_t num_chunks = static_cast<size_t>(metadata.num_row_groups()) * metadata.num_columns();
+    std::vector<int64_t> num_values;
+    std::vector<int64_t> total_uncompressed_size;
+    std::vector<int64_t> total_compressed_size;
+    std::vector<int64_t> data_page_offset;
+    std::vector<int64_t> dictionary_page_offset;
+    std::vector<int8_t> codec;
+    num_values.reserve(num_chunks);
+    total_uncompressed_size.reserve(num_chunks);
+    total_compressed_size.reserve(num_chunks);
+    data_page_offset.reserve(num_chunks);
+    dictionary_page_offset.reserve(num_chunks);
+    codec.reserve(num_chunks);
+    for (int i = 0; i < metadata.num_row_groups(); ++i) {
+        auto row_group = metadata.RowGroup(i);
+        for (int j = 0; j < row_group->num_columns(); ++j) {
+            auto column = row_group->ColumnChunk(j);
+            num_values.push_back(column->num_values());
+            total_uncompressed_size.push_back(column->total_uncompressed_size());
+            total_compressed_size.push_back(column->total_compressed_size());
+            data_page_offset.push_back(column->data_page_offset());
+            dictionary_page_offset.push_back(column->has_dictionary_page() ? column->dictionary_page_offset() : -1);
+            codec.push_back(ToFlatbuffer(column->compression()));
+        }
+    }
+    return parquet2::CreateColumnChunkVectors(
+        builder,
+        builder.CreateVector(num_values),
+        builder.CreateVector(total_uncompressed_size),
+        builder.CreateVector(total_compressed_size),
+        builder.CreateVector(data_page_offset),
+        builder.CreateVector(dictionary_page_offset),
+        builder.CreateVector(codec)
+    );
+}
+
+flatbuffers::Offset<parquet2::ColumnNameIndex> ConvertColumnNameIndex(const parquet::SchemaDescriptor& schema,
+                                                                      const std::vector<int32_t>& leaf_elements,
+                                                                      flatbuffers::FlatBufferBuilder& builder) {
+    std::vector<std::pair<uint64_t, int32_t>> entries;
+    entries.reserve(schema.num_columns());
+    for (int i = 0; i < schema.num_columns(); ++i) {
+        entries.emplace_back(ColumnNameHash(schema.Column(i)->path()->ToDotString()), i);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<uint64_t> hashes;
+    std::vector<int32_t> columns;
+    std::vector<int32_t> elements;
+    hashes.reserve(entries.size());
+    columns.reserve(entries.size());
+    elements.reserve(entries.size());
+    for (const auto& entry : entries) {
+        hashes.push_back(entry.first);
+        columns.push_back(entry.second);
+        elements.push_back(leaf_elements[entry.second]);
+    }
+    return parquet2::CreateColumnNameIndex(
+        builder, builder.CreateVector(hashes), builder.CreateVector(columns), builder.CreateVector(elements));
+}
+
+// Walks the schema depth-first, building the dot path of each leaf, until it
+// finds `name`. This is what a name lookup costs without a ColumnNameIndex.
+int ScanColumnIndex(const parquet2::FileMetaData& metadata, std::string_view name) {
+    const auto* elements = metadata.schema();
+    if (elements == nullptr || elements->size() == 0) {
+        return -1;
+    }
+    // Children still to visit, and path length before each, for every open group.
+    std::vector<std::pair<int, size_t>> groups{{elements->Get(0)->num_children(), 0}};
+    std::string path;
+    int leaf = 0;
+    for (flatbuffers::uoffset_t i = 1; i < elements->size() && !groups.empty(); ++i) {
+        const auto* element = elements->Get(i);
+        --groups.back().first;
+        size_t parent_length = path.size();
+        if (parent_length > 0) {
+            path += '.';
+        }
+        path += element->name() ? element->name()->string_view() : std::string_view();
+        if (element->num_children() > 0) {
+            groups.emplace_back(element->num_children(), parent_length);
+            continue;
+        }
+        if (path == name) {
+            return leaf;
+        }
+        ++leaf;
+        path.resize(parent_length);
+        while (!groups.empty() && groups.back().first == 0) {
+            path.resize(groups.back().second);
+            groups.pop_back();
+        }
+    }
+    return -1;
+}
+
+using FlatbufferSchema = flatbuffers::Vector<flatbuffers::Offset<parquet2::SchemaElement>>;
+
+// Rebuilds the schema subtree starting at elements[*pos]. Leaves that are not
+// selected are dropped, as are groups left without children; `leaves` collects the
+// original index of every leaf that is kept.
+parquet::schema::NodePtr BuildSchemaNode(const FlatbufferSchema& elements, const std::vector<bool>& selected,
+                                         bool is_root, int* pos, int* leaf, std::vector<int>* leaves) {
+    if (*pos >= static_cast<int>(elements.size())) {
+        throw parquet::ParquetException("FlatBuffer schema is truncated");
+    }
+    const auto* element = elements.Get((*pos)++);
+    std::string name = element->name() ? element->name()->str() : "";
+    auto repetition = element->repetition_type() == parquet2::FieldRepetitionType_UNSET
+        ? parquet::Repetition::REQUIRED
+        : static_cast<parquet::Repetition::type>(element->repetition_type());
+    auto converted_type = FromFlatbuffer(element->converted_type());
+    auto logical_type = FromFlatbuffer(*element);
+    int field_id = element->field_id().has_value() ? element->field_id().value() : -1;
+
+    if (is_root || element->num_children() > 0) {
+        parquet::schema::NodeVector fields;
+        for (int i = 0; i < element->num_children(); ++i) {
+            auto field = BuildSchemaNode(elements, selected, false, pos, leaf, leaves);
+            if (field) {
+                fields.push_back(std::move(field));
+            }
+        }
+        if (fields.empty() && !is_root) {
+            return nullptr;
+        }
+        if (logical_type) {
+            return parquet::schema::GroupNode::Make(name, repetition, fields, logical_type, field_id);
+        }
+        return parquet::schema::GroupNode::Make(name, repetition, fields, converted_type, field_id);
+    }
+
+    int index = (*leaf)++;
+    if (!selected[index]) {
+        return nullptr;
+    }
+    leaves->push_back(index);
+    auto physical_type = static_cast<parquet::Type::type>(element->type());
+    int type_length = element->type() == parquet2::Type_FIXED_LEN_BYTE_ARRAY ? element->type_length() : -1;
+    if (logical_type) {
+        return parquet::schema::PrimitiveNode::Make(name, repetition, logical_type, physical_type, type_length,
+                                                    field_id);
+    }
+    return parquet::schema::PrimitiveNode::Make(
+        name, repetition, physical_type, converted_type, type_length,
+        converted_type == parquet::ConvertedType::DECIMAL ? element->precision() : -1,
+        converted_type == parquet::ConvertedType::DECIMAL ? element->scale() : -1,
+        field_id);
+}
+
+// A page index location from a ColumnChunk, which marks a missing index with -1.
+std::optional<parquet::IndexLocation> ToIndexLocation(int64_t offset, int32_t length) {
+    if (offset < 0 || length <= 0) {
+        return std::nullopt;
+    }
+    return parquet::IndexLocation{offset, length};
+}
+
+void FinishColumnChunk(const parquet2::ColumnChunk& chunk, const ColumnChunkLocation& location,
+                       parquet::Type::type type, parquet::ColumnChunkMetaDataBuilder* builder) {
+    const auto* metadata = chunk.meta_data();
+    if (metadata == nullptr) {
+        throw parquet::ParquetException("FlatBuffer column chunk has no metadata");
+    }
+    if (chunk.file_path()) {
+        builder->set_file_path(chunk.file_path()->str());
+    }
+    if (metadata->statistics()) {
+        builder->SetStatistics(FromFlatbuffer(*metadata->statistics(), type));
+    }
+
+    bool has_dictionary = location.dictionary_page_offset >= 0;
+    std::map<parquet::Encoding::type, int32_t> dictionary_encoding_stats;
+    std::map<parquet::Encoding::type, int32_t> data_encoding_stats;
+    if (metadata->encoding_stats()) {
+        for (const auto* stats : *metadata->encoding_stats()) {
+            auto encoding = static_cast<parquet::Encoding::type>(stats->encoding());
+            if (stats->page_type() == parquet2::PageType_DICTIONARY_PAGE) {
+                dictionary_encoding_stats[encoding] += stats->count();
+            } else {
+                data_encoding_stats[encoding] += stats->count();
+            }
+        }
+    } else if (metadata->encodings()) {
+        // Without page encoding stats we only know which encodings appear, and
+        // whether every data page uses the dictionary.
+        for (auto encoding : *metadata->encodings()) {
+            bool is_dictionary = encoding == parquet2::Encoding_PLAIN_DICTIONARY ||
+                                 encoding == parquet2::Encoding_RLE_DICTIONARY;
+            bool is_level = encoding == parquet2::Encoding_RLE || encoding == parquet2::Encoding_BIT_PACKED;
+            if (!is_level && (is_dictionary || !metadata->is_fully_dict_encoded())) {
+                data_encoding_stats[static_cast<parquet::Encoding::type>(encoding)] = 1;
+            }
+        }
+        if (has_dictionary) {
+            dictionary_encoding_stats[parquet::Encoding::PLAIN] = 1;
+        }
+    }
+
+    builder->Finish(location.num_values,
+                    has_dictionary ? location.dictionary_page_offset : 0,
+                    metadata->index_page_offset(),
+                    location.data_page_offset,
+                    location.total_compressed_size,
+                    location.total_uncompressed_size,
+                    has_dictionary,
+                    false,
+                    dictionary_encoding_stats,
+                    data_encoding_stats);
+}
+
+}  // namespace
+
+flatbuffers::Offset<parquet2::FileMetaData> ConvertToFlatbuffer(const parquet::FileMetaData& metadata,
+                                                                flatbuffers::FlatBufferBuilder& builder,
+                                                                const FooterCodecOptions& options) {
+    std::vector<flatbuffers::Offset<parquet2::SchemaElement>> schema;
+    std::vector<int32_t> leaf_elements;
+    ConvertSchemaNode(*metadata.schema()->schema_root(), builder, &schema, &leaf_elements);
+    auto schema_offset = builder.CreateVector(schema);
+
+    std::vector<flatbuffers::Offset<parquet2::RowGroup>> row_groups;
+    row_groups.reserve(metadata.num_row_groups());
+    for (int i = 0; i < metadata.num_row_groups(); ++i) {
+        row_groups.push_back(ConvertRowGroup(*metadata.RowGroup(i), leaf_elements, options, builder));
+    }
+    auto row_groups_offset = builder.CreateVector(row_groups);
+
+    std::vector<flatbuffers::Offset<parquet2::KeyValue>> key_value_metadata;
+    if (metadata.key_value_metadata()) {
+        const auto& kv = *metadata.key_value_metadata();
+        for (int64_t i = 0; i < kv.size(); ++i) {
+            key_value_metadata.push_back(parquet2::CreateKeyValue(
+                builder, builder.CreateSharedString(kv.key(i)), builder.CreateString(kv.value(i))));
+        }
+    }
+    auto key_value_metadata_offset = builder.CreateVector(key_value_metadata);
+    auto created_by = builder.CreateString(metadata.created_by());
+    flatbuffers::Offset<parquet2::ColumnChunkVectors> column_chunk_vectors;
+    if (options.column_chunk_vectors) {
+        column_chunk_vectors = ConvertColumnChunkVectors(metadata, builder);
+    }
+    flatbuffers::Offset<parquet2::ColumnNameIndex> column_name_index;
+    if (options.column_name_index) {
+        column_name_index = ConvertColumnNameIndex(*metadata.schema(), leaf_elements, builder);
+    }
+
+    parquet2::FileMetaDataBuilder result(builder);
+    result.add_version(metadata.version() == parquet::ParquetVersion::PARQUET_1_0 ? 1 : 2);
+    result.add_schema(schema_offset);
+    result.add_num_rows(metadata.num_rows());
+    result.add_row_groups(row_groups_offset);
+    result.add_key_value_metadata(key_value_metadata_offset);
+    result.add_created_by(created_by);
+    if (!column_chunk_vectors.IsNull()) {
+        result.add_column_chunk_vectors(column_chunk_vectors);
+    }
+    if (!column_name_index.IsNull()) {
+        result.add_column_name_index(column_name_index);
+    }
+    return result.Finish();
+}
+
+std::string ConvertToFlatbuffer(const parquet::FileMetaData& metadata, const FooterCodecOptions& options) {
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(ConvertToFlatbuffer(metadata, builder, options));
+    return std::string(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+uint64_t ColumnNameHash(std::string_view name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int FindColumnIndex(const parquet2::FileMetaData& metadata, std::string_view name) {
+    const auto* index = metadata.column_name_index();
+    if (index == nullptr || index->hashes() == nullptr) {
+        return ScanColumnIndex(metadata, name);
+    }
+    uint64_t hash = ColumnNameHash(name);
+    const auto* hashes = index->hashes();
+    flatbuffers::uoffset_t first = 0;
+    flatbuffers::uoffset_t last = hashes->size();
+    while (first < last) {
+        auto mid = first + (last - first) / 2;
+        if (hashes->Get(mid) < hash) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    // The leaf element's name is the last component of its path; checking it
+    // rules out the hash collisions that matter in practice.
+    size_t dot = name.rfind('.');
+    std::string_view leaf_name = dot == std::string_view::npos ? name : name.substr(dot + 1);
+    for (auto i = first; i < hashes->size() && hashes->Get(i) == hash; ++i) {
+        const auto* element = metadata.schema()->Get(index->elements()->Get(i));
+        if (element->name() && element->name()->string_view() == leaf_name) {
+            return index->columns()->Get(i);
+        }
+    }
+    return -1;
+}
+
+ColumnChunkLocation GetColumnChunkLocation(const parquet2::FileMetaData& metadata, int row_group, int column) {
+    ColumnChunkLocation location;
+    if (const auto* vectors = metadata.column_chunk_vectors()) {
+        auto num_columns = metadata.row_groups()->Get(row_group)->columns()->size();
+        auto i = static_cast<flatbuffers::uoffset_t>(row_group) * num_columns + column;
+        location.num_values = vectors->num_values()->Get(i);
+        location.total_uncompressed_size = vectors->total_uncompressed_size()->Get(i);
+        location.total_compressed_size = vectors->total_compressed_size()->Get(i);
+        location.data_page_offset = vectors->data_page_offset()->Get(i);
+        location.dictionary_page_offset = vectors->dictionary_page_offset()->Get(i);
+        location.codec = static_cast<parquet2::CompressionCodec>(vectors->codec()->Get(i));
+        return location;
+    }
+    const auto* chunk = metadata.row_groups()->Get(row_group)->columns()->Get(column)->meta_data();
+    if (chunk == nullptr) {
+        throw parquet::ParquetException("FlatBuffer column chunk has no metadata");
+    }
+    location.num_values = chunk->num_values();
+    location.total_uncompressed_size = chunk->total_uncompressed_size();
+    location.total_compressed_size = chunk->total_compressed_size();
+    location.data_page_offset = chunk->data_page_offset();
+    location.dictionary_page_offset = chunk->dictionary_page_offset();
+    location.codec = chunk->codec();
+    return location;
+}
+
+std::shared_ptr<parquet::FileMetaData> ConvertFromFlatbuffer(const parquet2::FileMetaData& metadata,
+                                                             const std::vector<int>& column_indices) {
+    const auto* elements = metadata.schema();
+    if (elements == nullptr || elements->size() == 0) {
+        throw parquet::ParquetException("FlatBuffer footer has no schema");
+    }
+    int num_columns = 0;
+    for (flatbuffers::uoffset_t i = 1; i < elements->size(); ++i) {
+        if (elements->Get(i)->num_children() == 0) {
+            ++num_columns;
+        }
+    }
+    std::vector<bool> selected(num_columns, column_indices.empty());
+    for (int i : column_indices) {
+        if (i < 0 || i >= num_columns) {
+            throw parquet::ParquetException("Column index ", i, " out of range for ", num_columns, " columns");
+        }
+        selected[i] = true;
+    }
+
+    int pos = 0;
+    int leaf = 0;
+    std::vector<int> leaves;
+    parquet::SchemaDescriptor schema;
+    schema.Init(BuildSchemaNode(*elements, selected, true, &pos, &leaf, &leaves));
+
+    parquet::WriterProperties::Builder properties;
+    properties.version(metadata.version() == 1 ? parquet::ParquetVersion::PARQUET_1_0
+                                               : parquet::ParquetVersion::PARQUET_2_6);
+    if (metadata.created_by()) {
+        // Also determines the writer version the reader applies workarounds for.
+        properties.created_by(metadata.created_by()->str());
+    }
+
+    const auto* row_groups = metadata.row_groups();
+    // The metadata builder takes each chunk's codec from the writer properties,
+    // so a column can only have one codec across the row groups.
+    std::vector<parquet2::CompressionCodec> codecs;
+    if (row_groups && row_groups->size() > 0 && !leaves.empty()) {
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            codecs.push_back(GetColumnChunkLocation(metadata, 0, leaves[i]).codec);
+        }
+        properties.compression(FromFlatbuffer(codecs[0]));
+        for (size_t i = 1; i < leaves.size(); ++i) {
+            if (codecs[i] != codecs[0]) {
+                properties.compression(schema.Column(static_cast<int>(i))->path(), FromFlatbuffer(codecs[i]));
+            }
+        }
+    }
+
+    auto builder = parquet::FileMetaDataBuilder::Make(&schema, properties.build());
+    parquet::PageIndexLocation page_index_location;
+    if (row_groups) {
+        const auto* vectors = metadata.column_chunk_vectors();
+        size_t num_chunks = static_cast<size_t>(row_groups->size()) * num_columns;
+        if (vectors && (!vectors->num_values() || vectors->num_values()->size() != num_chunks)) {
+            throw parquet::ParquetException("FlatBuffer column chunk vectors do not match the row groups");
+        }
+        for (flatbuffers::uoffset_t rg = 0; rg < row_groups->size(); ++rg) {
+            const auto* row_group = row_groups->Get(rg);
+            if (row_group->columns() == nullptr || static_cast<int>(row_group->columns()->size()) != num_columns) {
+                throw parquet::ParquetException("FlatBuffer row group does not match the schema");
+            }
+            auto* row_group_builder = builder->AppendRowGroup();
+            row_group_builder->set_num_rows(row_group->num_rows());
+            int64_t total_byte_size = 0;
+            auto& column_index_locations = page_index_location.column_index_location[rg];
+            auto& offset_index_locations = page_index_location.offset_index_location[rg];
+            for (size_t i = 0; i < leaves.size(); ++i) {
+                auto location = GetColumnChunkLocation(metadata, rg, leaves[i]);
+                if (location.codec != codecs[i]) {
+                    throw parquet::ParquetException("Column ", leaves[i], " changes codec in row group ", rg,
+                                                    ", which the FlatBuffer footer cannot convert");
+                }
+                const auto* chunk = row_group->columns()->Get(leaves[i]);
+                FinishColumnChunk(*chunk, location, schema.Column(static_cast<int>(i))->physical_type(),
+                                  row_group_builder->NextColumnChunk());
+                total_byte_size += location.total_uncompressed_size;
+                column_index_locations.push_back(
+                    ToIndexLocation(chunk->column_index_offset(), chunk->column_index_length()));
+                offset_index_locations.push_back(
+                    ToIndexLocation(chunk->offset_index_offset(), chunk->offset_index_length()));
+            }
+            row_group_builder->Finish(column_indices.empty() ? row_group->total_byte_size() : total_byte_size);
+        }
+        // Applied to the row groups appended so far, so after the last of them
+        builder->SetPageIndexLocation(page_index_location);
+    }
+
+    std::shared_ptr<arrow::KeyValueMetadata> key_value_metadata;
+    if (metadata.key_value_metadata() && metadata.key_value_metadata()->size() > 0) {
+        key_value_metadata = std::make_shared<arrow::KeyValueMetadata>();
+        for (const auto* kv : *metadata.key_value_metadata()) {
+            std::string key = kv->key() ? kv->key()->str() : "";
+            // The stored Arrow schema describes every column, so it would be applied
+            // to the wrong fields of a projected schema.
+            if (!column_indices.empty() && key == "ARROW:schema") {
+                continue;
+            }
+            key_value_metadata->Append(key, kv->value() ? kv->value()->str() : "");
+        }
+    }
+    return builder->Finish(key_value_metadata);
+}
@@ -0,0 +1,81 @@
+#ifndef FOOTER_CODEC_H
+#define FOOTER_CODEC_H
+
+#include <parquet/metadata.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flatbuff_ns_generated.h"
+
+// Footer size optimizations applied while encoding the parquet2 FlatBuffer.
+// Decoding understands every combination.
+struct FooterCodecOptions {
+    // Fixed-width min/max values are stored inline as min8/max8, and the
+    // deprecated min/max fields are dropped.
+    bool optimize_statistics = false;
+    // Page encoding stats are replaced by a single is_fully_dict_encoded flag.
+    bool optimize_encodings = false;
+    // The per-chunk type and path_in_schema are replaced by schema_index.
+    bool optimize_path_in_schema = false;
+    // Hot column chunk fields are written as parallel vectors in
+    // ColumnChunkVectors instead of in each ColumnMetadata table.
+    bool column_chunk_vectors = false;
+    // A ColumnNameIndex is added so FindColumnIndex resolves names in O(log n).
+    bool column_name_index = false;
+
+    static FooterCodecOptions None() { return {}; }
+    static FooterCodecOptions T1() {
+        FooterCodecOptions options;
+        options.optimize_statistics = true;
+        options.optimize_encodings = true;
+        return options;
+    }
+    static FooterCodecOptions T2() {
+        FooterCodecOptions options;
+        options.optimize_path_in_schema = true;
+        return options;
+    }
+    static FooterCodecOptions All() {
+        FooterCodecOptions options = T1();
+        options.optimize_path_in_schema = true;
+        return options;
+    }
+};
+
+// Converts Arrow's view of a Thrift footer into a parquet2 FlatBuffer: the full
+// schema tree with logical types, statistics, encoding stats, key/value metadata
+// and all page/index offsets.
+flatbuffers::Offset<parquet2::FileMetaData> ConvertToFlatbuffer(const parquet::FileMetaData& metadata,
+                                                                flatbuffers::FlatBufferBuilder& builder,
+                                                                const FooterCodecOptions& options = {});
+std::string ConvertToFlatbuffer(const parquet::FileMetaData& metadata, const FooterCodecOptions& options = {});
+
+// The column chunk fields that scan planning reads, taken from ColumnChunkVectors
+// when the FlatBuffer has them and from the ColumnMetadata table otherwise.
+struct ColumnChunkLocation {
+    int64_t num_values = 0;
+    int64_t total_uncompressed_size = 0;
+    int64_t total_compressed_size = 0;
+    int64_t data_page_offset = 0;
+    int64_t dictionary_page_offset = -1;
+    parquet2::CompressionCodec codec = parquet2::CompressionCodec_UNCOMPRESSED;
+};
+ColumnChunkLocation GetColumnChunkLocation(const parquet2::FileMetaData& metadata, int row_group, int column);
+
+// The 64-bit FNV-1a hash ColumnNameIndex is keyed by.
+uint64_t ColumnNameHash(std::string_view name);
+
+// Returns the leaf column index of the column whose dot-separated path is `name`,
+// or -1 if there is none. Uses the ColumnNameIndex when the FlatBuffer has one and
+// walks the schema otherwise.
+int FindColumnIndex(const parquet2::FileMetaData& metadata, std::string_view name);
+
+// Builds the parquet::FileMetaData that parquet::ParquetFileReader needs from a
+// parquet2 FlatBuffer, without any Thrift decode. When `column_indices` is
+// non-empty, the schema and row groups only describe those leaf columns, in file
+// order. Throws parquet::ParquetException on inconsistent input.
+std::shared_ptr<parquet::FileMetaData> ConvertFromFlatbuffer(const parquet2::FileMetaData& metadata,
+                                                             const std::vector<int>& column_indices = {});
+
+#endif  // FOOTER_CODEC_H
@@ -0,0 +1,323 @@
+#include "benchmark_flags.h"
+#include "footer_codec.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "data_generator.h"
+#include <arrow/io/file.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+// Footer size and parse time of the parquet2 FlatBuffer for each combination of
+// FooterCodecOptions, against the Thrift footer of the same file. Pass Parquet
+// files on the command line, or run without arguments to generate
+// footer_codec_{2000,3000,10000}cols.parquet with chunk statistics. The Layout
+// benchmarks compare the table-per-chunk layout with ColumnChunkVectors, and
+// NameLookup compares ColumnNameIndex with a schema walk.
+
+namespace {
+
+struct FooterFile {
+    std::string name;
+    std::string thrift;
+    std::shared_ptr<parquet::FileMetaData> metadata;
+};
+
+std::vector<FooterFile> footer_files;
+
+const char* kLevelNames[] = {"None", "T1", "T2", "All"};
+
+FooterCodecOptions OptionsForLevel(int64_t level) {
+    switch (level) {
+        case 1: return FooterCodecOptions::T1();
+        case 2: return FooterCodecOptions::T2();
+        case 3: return FooterCodecOptions::All();
+        default: return FooterCodecOptions::None();
+    }
+}
+
+FooterFile LoadFooter(const std::string& filename) {
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(filename));
+    std::shared_ptr<arrow::Buffer> footer;
+    PARQUET_ASSIGN_OR_THROW(footer, ReadFooterBytes(file.get()));
+
+    FooterFile result;
+    result.name = filename;
+    result.thrift = footer->ToString();
+    auto metadata_len = static_cast<uint32_t>(footer->size());
+    result.metadata = parquet::FileMetaData::Make(footer->data(), &metadata_len);
+    return result;
+}
+
+void SetSizeCounters(benchmark::State& state, const FooterFile& footer, size_t flatbuffer_size) {
+    state.SetLabel(footer.name);
+    state.counters["NumColumns"] = footer.metadata->num_columns();
+    state.counters["ThriftSize"] = footer.thrift.size();
+    state.counters["FlatbufferSize"] = flatbuffer_size;
+}
+
+void BM_FooterCodecThriftParse(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    for (auto _ : state) {
+        uint32_t metadata_len = footer.thrift.size();
+        auto metadata = parquet::FileMetaData::Make(footer.thrift.data(), &metadata_len);
+        benchmark::DoNotOptimize(metadata);
+    }
+    SetSizeCounters(state, footer, 0);
+}
+
+void BM_FooterCodecEncode(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    auto options = OptionsForLevel(state.range(1));
+    size_t flatbuffer_size = 0;
+    for (auto _ : state) {
+        flatbuffers::FlatBufferBuilder builder;
+        builder.Finish(ConvertToFlatbuffer(*footer.metadata, builder, options));
+        flatbuffer_size = builder.GetSize();
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    SetSizeCounters(state, footer, flatbuffer_size);
+}
+
+// Accessing the root and walking every column chunk is what a FlatBuffer "parse" costs.
+void BM_FooterCodecFlatbufParse(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, OptionsForLevel(state.range(1)));
+    for (auto _ : state) {
+        auto metadata = parquet2::GetFileMetaData(flatbuffer.data());
+        int64_t num_values = 0;
+        for (const auto* row_group : *metadata->row_groups()) {
+            for (const auto* column : *row_group->columns()) {
+                num_values += column->meta_data()->num_values();
+            }
+        }
+        benchmark::DoNotOptimize(num_values);
+    }
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+void BM_FooterCodecFlatbufVerify(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, OptionsForLevel(state.range(1)));
+    for (auto _ : state) {
+        flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(flatbuffer.data()), flatbuffer.size());
+        if (!parquet2::VerifyFileMetaDataBuffer(verifier)) {
+            state.SkipWithError("FlatBuffer footer failed verification");
+            break;
+        }
+    }
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+// Rebuilding the parquet::FileMetaData the Parquet reader needs from the FlatBuffer.
+void BM_FooterCodecDecode(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, OptionsForLevel(state.range(1)));
+    for (auto _ : state) {
+        auto metadata = ConvertFromFlatbuffer(*parquet2::GetFileMetaData(flatbuffer.data()));
+        benchmark::DoNotOptimize(metadata);
+    }
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+// Layout 0 keeps every field in the ColumnMetadata tables, layout 1 moves the hot
+// fields into ColumnChunkVectors.
+FooterCodecOptions OptionsForLayout(int64_t layout) {
+    FooterCodecOptions options;
+    options.column_chunk_vectors = layout == 1;
+    return options;
+}
+
+void BM_FooterCodecLayoutEncode(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    auto options = OptionsForLayout(state.range(1));
+    size_t flatbuffer_size = 0;
+    for (auto _ : state) {
+        flatbuffers::FlatBufferBuilder builder;
+        builder.Finish(ConvertToFlatbuffer(*footer.metadata, builder, options));
+        flatbuffer_size = builder.GetSize();
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    SetSizeCounters(state, footer, flatbuffer_size);
+}
+
+void BM_FooterCodecLayoutDecode(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, OptionsForLayout(state.range(1)));
+    for (auto _ : state) {
+        auto metadata = ConvertFromFlatbuffer(*parquet2::GetFileMetaData(flatbuffer.data()));
+        benchmark::DoNotOptimize(metadata);
+    }
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+// Sums the byte ranges of `range(2)` randomly chosen columns in every row group, the
+// way a scan planner does. Run with --benchmark_perf_counters=CACHE-MISSES (libpfm
+// builds of google-benchmark) to see the cache misses per planned column.
+void BM_FooterCodecLayoutScan(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, OptionsForLayout(state.range(1)));
+    int num_columns = footer.metadata->num_columns();
+    int num_planned = std::min<int>(state.range(2), num_columns);
+
+    std::vector<int> columns(num_columns);
+    std::iota(columns.begin(), columns.end(), 0);
+    std::mt19937 gen(42);
+    std::shuffle(columns.begin(), columns.end(), gen);
+    columns.resize(num_planned);
+
+    for (auto _ : state) {
+        const auto* metadata = parquet2::GetFileMetaData(flatbuffer.data());
+        int64_t total_bytes = 0;
+        int num_row_groups = metadata->row_groups()->size();
+        if (const auto* vectors = metadata->column_chunk_vectors()) {
+            const auto* data_page_offset = vectors->data_page_offset();
+            const auto* total_compressed_size = vectors->total_compressed_size();
+            for (int rg = 0; rg < num_row_groups; ++rg) {
+                for (int column : columns) {
+                    int i = rg * num_columns + column;
+                    total_bytes += data_page_offset->Get(i) + total_compressed_size->Get(i);
+                }
+            }
+        } else {
+            for (int rg = 0; rg < num_row_groups; ++rg) {
+                const auto* chunks = metadata->row_groups()->Get(rg)->columns();
+                for (int column : columns) {
+                    const auto* chunk = chunks->Get(column)->meta_data();
+                    total_bytes += chunk->data_page_offset() + chunk->total_compressed_size();
+                }
+            }
+        }
+        benchmark::DoNotOptimize(total_bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * num_planned * footer.metadata->num_row_groups());
+    state.counters["PlannedColumns"] = num_planned;
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+// Resolves `range(2)` column names to leaf indices, through the ColumnNameIndex
+// when range(1) is 1 and by walking the schema otherwise.
+void BM_FooterCodecNameLookup(benchmark::State& state) {
+    const auto& footer = footer_files[state.range(0)];
+    FooterCodecOptions options;
+    options.column_name_index = state.range(1) == 1;
+    std::string flatbuffer = ConvertToFlatbuffer(*footer.metadata, options);
+    int num_columns = footer.metadata->num_columns();
+    int num_names = std::min<int>(state.range(2), num_columns);
+
+    std::vector<int> columns(num_columns);
+    std::iota(columns.begin(), columns.end(), 0);
+    std::mt19937 gen(42);
+    std::shuffle(columns.begin(), columns.end(), gen);
+    std::vector<std::string> names;
+    for (int i = 0; i < num_names; ++i) {
+        names.push_back(footer.metadata->schema()->Column(columns[i])->path()->ToDotString());
+    }
+
+    for (auto _ : state) {
+        const auto* metadata = parquet2::GetFileMetaData(flatbuffer.data());
+        for (const auto& name : names) {
+            int index = FindColumnIndex(*metadata, name);
+            if (index < 0) {
+                state.SkipWithError(("Column " + name + " not found").c_str());
+                return;
+            }
+            benchmark::DoNotOptimize(index);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_names);
+    state.counters["Names"] = num_names;
+    SetSizeCounters(state, footer, flatbuffer.size());
+}
+
+std::vector<std::string> GenerateTestFiles() {
+    std::vector<std::string> filenames;
+    for (int num_columns : {2000, 3000, 10000}) {
+        std::string filename = "footer_codec_" + std::to_string(num_columns) + "cols.parquet";
+        if (std::ifstream(filename)) {
+            std::cout << "File " << filename << " already exists. Skipping..." << std::endl;
+        } else {
+            PARQUET_THROW_NOT_OK(DataGenerator::WriteParquetFile(num_columns, 1000, filename, StatsLevel::CHUNK));
+            std::cout << "Generated file: " << filename << std::endl;
+        }
+        filenames.push_back(filename);
+    }
+    return filenames;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+
+    try {
+        std::vector<std::string> filenames(argv + 1, argv + argc);
+        if (filenames.empty()) {
+            filenames = GenerateTestFiles();
+        }
+        for (const auto& filename : filenames) {
+            footer_files.push_back(LoadFooter(filename));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading footers: " << e.what() << std::endl;
+        return 1;
+    }
+
+    for (size_t i = 0; i < footer_files.size(); ++i) {
+        const auto& footer = footer_files[i];
+        std::string sizes = footer.name + ": thrift=" + std::to_string(footer.thrift.size());
+        for (int level = 0; level < 4; ++level) {
+            sizes += std::string(", ") + kLevelNames[level] + "=" +
+                     std::to_string(ConvertToFlatbuffer(*footer.metadata, OptionsForLevel(level)).size());
+        }
+        ::benchmark::AddCustomContext("footer_sizes_" + std::to_string(i), sizes);
+
+        ::benchmark::RegisterBenchmark("BM_FooterCodecThriftParse", BM_FooterCodecThriftParse)
+            ->Arg(i)->Unit(benchmark::kMillisecond);
+        for (int level = 0; level < 4; ++level) {
+            std::string suffix = std::string("/") + kLevelNames[level];
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecEncode" + suffix).c_str(), BM_FooterCodecEncode)
+                ->Args({static_cast<int64_t>(i), level})->Unit(benchmark::kMillisecond);
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecFlatbufParse" + suffix).c_str(), BM_FooterCodecFlatbufParse)
+                ->Args({static_cast<int64_t>(i), level})->Unit(benchmark::kMicrosecond);
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecFlatbufVerify" + suffix).c_str(), BM_FooterCodecFlatbufVerify)
+                ->Args({static_cast<int64_t>(i), level})->Unit(benchmark::kMillisecond);
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecDecode" + suffix).c_str(), BM_FooterCodecDecode)
+                ->Args({static_cast<int64_t>(i), level})->Unit(benchmark::kMillisecond);
+        }
+        for (int layout = 0; layout < 2; ++layout) {
+            std::string suffix = layout == 1 ? "/Vectors" : "/Tables";
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecLayoutEncode" + suffix).c_str(), BM_FooterCodecLayoutEncode)
+                ->Args({static_cast<int64_t>(i), layout})->Unit(benchmark::kMillisecond);
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecLayoutDecode" + suffix).c_str(), BM_FooterCodecLayoutDecode)
+                ->Args({static_cast<int64_t>(i), layout})->Unit(benchmark::kMillisecond);
+            ::benchmark::RegisterBenchmark(("BM_FooterCodecLayoutScan" + suffix).c_str(), BM_FooterCodecLayoutScan)
+                ->ArgsProduct({{static_cast<int64_t>(i)}, {layout}, {10, 100, 1000, 10000}})
+                ->Unit(benchmark::kMicrosecond);
+        }
+        ::benchmark::RegisterBenchmark("BM_FooterCodecNameLookup", BM_FooterCodecNameLookup)
+            ->ArgsProduct({{static_cast<int64_t>(i)}, {0, 1}, {1, 10, 100, 1000, 10000}})
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
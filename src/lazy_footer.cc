@@ -0,0 +1,415 @@
+#include "lazy_footer.h"
+#include "benchmark_io.h"
+#include <parquet/exception.h>
+
+namespace {
+
+// Thrift compact protocol type ids.
+enum CompactType : uint8_t {
+    kStop = 0,
+    kBooleanTrue = 1,
+    kBooleanFalse = 2,
+    kByte = 3,
+    kI16 = 4,
+    kI32 = 5,
+    kI64 = 6,
+    kDouble = 7,
+    kBinary = 8,
+    kList = 9,
+    kSet = 10,
+    kMap = 11,
+    kStruct = 12,
+};
+
+constexpr int kMaxNestingDepth = 64;
+
+// Minimal reader for the subset of the Thrift compact protocol used by the
+// Parquet footer. Every read is bounds checked.
+class CompactReader {
+public:
+    CompactReader(const uint8_t* data, int64_t size, int64_t pos = 0) : data_(data), size_(size), pos_(pos) {
+        if (pos_ > size_) {
+            Fail();
+        }
+    }
+
+    int64_t position() const { return pos_; }
+
+    // Reads the next field header of the current struct; `last_id` carries the
+    // previous field id of that struct. Returns false at the struct's stop byte.
+    bool ReadFieldBegin(int16_t* last_id, int16_t* id, uint8_t* type) {
+        uint8_t header = ReadByte();
+        if (header == kStop) {
+            return false;
+        }
+        *type = header & 0x0F;
+        int16_t delta = header >> 4;
+        *id = delta != 0 ? static_cast<int16_t>(*last_id + delta) : static_cast<int16_t>(ReadZigZag());
+        *last_id = *id;
+        return true;
+    }
+
+    void ReadListBegin(uint8_t* element_type, uint32_t* size) {
+        uint8_t header = ReadByte();
+        *element_type = header & 0x0F;
+        *size = header >> 4;
+        if (*size == 15) {
+            *size = static_cast<uint32_t>(ReadVarint());
+        }
+        // Every element takes at least one byte, which bounds hostile sizes.
+        if (*size > size_ - pos_) {
+            Fail();
+        }
+    }
+
+    int32_t ReadI32() { return static_cast<int32_t>(ReadZigZag()); }
+    int64_t ReadI64() { return ReadZigZag(); }
+
+    std::string ReadString() {
+        uint64_t length = ReadVarint();
+        Need(length);
+        std::string value(reinterpret_cast<const char*>(data_ + pos_), length);
+        pos_ += length;
+        return value;
+    }
+
+    void Skip(uint8_t type, int depth = 0) {
+        if (depth > kMaxNestingDepth) {
+            Fail();
+        }
+        switch (type) {
+            case kBooleanTrue:
+            case kBooleanFalse:
+                // Field values are carried in the header.
+                break;
+            case kByte:
+                Advance(1);
+                break;
+            case kI16:
+            case kI32:
+            case kI64:
+                ReadVarint();
+                break;
+            case kDouble:
+                Advance(8);
+                break;
+            case kBinary:
+                Advance(ReadVarint());
+                break;
+            case kList:
+            case kSet: {
+                uint8_t element_type;
+                uint32_t size;
+                ReadListBegin(&element_type, &size);
+                for (uint32_t i = 0; i < size; ++i) {
+                    SkipElement(element_type, depth + 1);
+                }
+                break;
+            }
+            case kMap: {
+                uint64_t size = ReadVarint();
+                if (size == 0) {
+                    break;
+                }
+                uint8_t types = ReadByte();
+                for (uint64_t i = 0; i < size; ++i) {
+                    SkipElement(types >> 4, depth + 1);
+                    SkipElement(types & 0x0F, depth + 1);
+                }
+                break;
+            }
+            case kStruct: {
+                int16_t last_id = 0;
+                int16_t id;
+                uint8_t field_type;
+                while (ReadFieldBegin(&last_id, &id, &field_type)) {
+                    Skip(field_type, depth + 1);
+                }
+                break;
+            }
+            default:
+                Fail();
+        }
+    }
+
+private:
+    // Container elements store booleans as a full byte.
+    void SkipElement(uint8_t type, int depth) {
+        if (type == kBooleanTrue || type == kBooleanFalse) {
+            Advance(1);
+        } else {
+            Skip(type, depth);
+        }
+    }
+
+    [[noreturn]] void Fail() const {
+        throw parquet::ParquetException("Malformed Thrift footer at byte ", pos_, " of ", size_);
+    }
+
+    void Need(uint64_t n) const {
+        if (n > static_cast<uint64_t>(size_ - pos_)) {
+            Fail();
+        }
+    }
+
+    void Advance(uint64_t n) {
+        Need(n);
+        pos_ += n;
+    }
+
+    uint8_t ReadByte() {
+        Need(1);
+        return data_[pos_++];
+    }
+
+    uint64_t ReadVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = ReadByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        Fail();
+    }
+
+    int64_t ReadZigZag() {
+        uint64_t value = ReadVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    const uint8_t* data_;
+    int64_t size_;
+    int64_t pos_;
+};
+
+parquet::Compression::type FromThrift(int32_t codec) {
+    switch (codec) {
+        case 1: return parquet::Compression::SNAPPY;
+        case 2: return parquet::Compression::GZIP;
+        case 3: return parquet::Compression::LZO;
+        case 4: return parquet::Compression::BROTLI;
+        case 5: return parquet::Compression::LZ4_HADOOP;
+        case 6: return parquet::Compression::ZSTD;
+        case 7: return parquet::Compression::LZ4;
+        default: return parquet::Compression::UNCOMPRESSED;
+    }
+}
+
+void DecodeStatistics(CompactReader& reader, parquet::EncodedStatistics* statistics) {
+    std::string min, max, min_value, max_value;
+    bool has_min = false, has_max = false, has_min_value = false, has_max_value = false;
+    int16_t last_id = 0;
+    int16_t id;
+    uint8_t type;
+    while (reader.ReadFieldBegin(&last_id, &id, &type)) {
+        if (id == 1 && type == kBinary) {
+            max = reader.ReadString();
+            has_max = true;
+        } else if (id == 2 && type == kBinary) {
+            min = reader.ReadString();
+            has_min = true;
+        } else if (id == 3 && type == kI64) {
+            statistics->set_null_count(reader.ReadI64());
+        } else if (id == 4 && type == kI64) {
+            statistics->set_distinct_count(reader.ReadI64());
+        } else if (id == 5 && type == kBinary) {
+            max_value = reader.ReadString();
+            has_max_value = true;
+        } else if (id == 6 && type == kBinary) {
+            min_value = reader.ReadString();
+            has_min_value = true;
+        } else {
+            reader.Skip(type);
+        }
+    }
+    // Prefer the sort-order aware fields over the deprecated ones.
+    if (has_min_value || has_min) {
+        statistics->set_min(has_min_value ? min_value : min);
+    }
+    if (has_max_value || has_max) {
+        statistics->set_max(has_max_value ? max_value : max);
+    }
+}
+
+void DecodeColumnMetaData(CompactReader& reader, LazyColumnChunk* chunk) {
+    int16_t last_id = 0;
+    int16_t id;
+    uint8_t type;
+    while (reader.ReadFieldBegin(&last_id, &id, &type)) {
+        if (id == 1 && type == kI32) {
+            chunk->type = static_cast<parquet::Type::type>(reader.ReadI32());
+        } else if (id == 2 && type == kList) {
+            uint8_t element_type;
+            uint32_t size;
+            reader.ReadListBegin(&element_type, &size);
+            for (uint32_t i = 0; i < size; ++i) {
+                chunk->encodings.push_back(static_cast<parquet::Encoding::type>(reader.ReadI32()));
+            }
+        } else if (id == 3 && type == kList) {
+            uint8_t element_type;
+            uint32_t size;
+            reader.ReadListBegin(&element_type, &size);
+            for (uint32_t i = 0; i < size; ++i) {
+                chunk->path_in_schema.push_back(reader.ReadString());
+            }
+        } else if (id == 4 && type == kI32) {
+            chunk->codec = FromThrift(reader.ReadI32());
+        } else if (id == 5 && type == kI64) {
+            chunk->num_values = reader.ReadI64();
+        } else if (id == 6 && type == kI64) {
+            chunk->total_uncompressed_size = reader.ReadI64();
+        } else if (id == 7 && type == kI64) {
+            chunk->total_compressed_size = reader.ReadI64();
+        } else if (id == 9 && type == kI64) {
+            chunk->data_page_offset = reader.ReadI64();
+        } else if (id == 10 && type == kI64) {
+            chunk->index_page_offset = reader.ReadI64();
+        } else if (id == 11 && type == kI64) {
+            chunk->dictionary_page_offset = reader.ReadI64();
+        } else if (id == 12 && type == kStruct) {
+            DecodeStatistics(reader, &chunk->statistics);
+        } else {
+            reader.Skip(type);
+        }
+    }
+}
+
+}  // namespace
+
+arrow::Result<std::shared_ptr<LazyFooter>> LazyFooter::Make(std::shared_ptr<arrow::Buffer> footer) {
+    std::shared_ptr<LazyFooter> result(new LazyFooter(std::move(footer)));
+    PARQUET_CATCH_NOT_OK(result->Scan());
+    return result;
+}
+
+arrow::Result<std::shared_ptr<LazyFooter>> LazyFooter::Open(std::shared_ptr<arrow::io::RandomAccessFile> file) {
+    ARROW_ASSIGN_OR_RAISE(auto footer, ReadFooterBytes(file.get()));
+    return Make(std::move(footer));
+}
+
+void LazyFooter::Scan() {
+    CompactReader reader(footer_->data(), footer_->size());
+    int16_t last_id = 0;
+    int16_t id;
+    uint8_t type;
+    while (reader.ReadFieldBegin(&last_id, &id, &type)) {
+        if (id == 1 && type == kI32) {
+            version_ = reader.ReadI32();
+        } else if (id == 2 && type == kList) {
+            uint8_t element_type;
+            uint32_t size;
+            reader.ReadListBegin(&element_type, &size);
+            for (uint32_t i = 0; i < size; ++i) {
+                // Only num_children is needed to tell leaves from groups.
+                int64_t offset = reader.position();
+                int32_t num_children = 0;
+                int16_t element_last_id = 0;
+                while (reader.ReadFieldBegin(&element_last_id, &id, &type)) {
+                    if (id == 5 && type == kI32) {
+                        num_children = reader.ReadI32();
+                    } else {
+                        reader.Skip(type);
+                    }
+                }
+                // Element 0 is the schema root
+                if (i > 0 && num_children == 0) {
+                    leaf_offsets_.push_back(static_cast<uint32_t>(offset));
+                }
+            }
+        } else if (id == 3 && type == kI64) {
+            num_rows_ = reader.ReadI64();
+        } else if (id == 4 && type == kList) {
+            uint8_t element_type;
+            uint32_t size;
+            reader.ReadListBegin(&element_type, &size);
+            row_groups_.reserve(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                RowGroupInfo row_group;
+                row_group.first_column = column_offsets_.size();
+                int16_t row_group_last_id = 0;
+                while (reader.ReadFieldBegin(&row_group_last_id, &id, &type)) {
+                    if (id == 1 && type == kList) {
+                        uint32_t num_chunks;
+                        reader.ReadListBegin(&element_type, &num_chunks);
+                        for (uint32_t j = 0; j < num_chunks; ++j) {
+                            column_offsets_.push_back(static_cast<uint32_t>(reader.position()));
+                            reader.Skip(kStruct);
+                        }
+                    } else if (id == 2 && type == kI64) {
+                        row_group.total_byte_size = reader.ReadI64();
+                    } else if (id == 3 && type == kI64) {
+                        row_group.num_rows = reader.ReadI64();
+                    } else {
+                        reader.Skip(type);
+                    }
+                }
+                row_groups_.push_back(row_group);
+            }
+        } else {
+            reader.Skip(type);
+        }
+    }
+
+    for (size_t i = 0; i < row_groups_.size(); ++i) {
+        size_t end = i + 1 < row_groups_.size() ? row_groups_[i + 1].first_column : column_offsets_.size();
+        if (end - row_groups_[i].first_column != leaf_offsets_.size()) {
+            throw parquet::ParquetException("Row group ", i, " has ", end - row_groups_[i].first_column,
+                                            " column chunks but the schema has ", leaf_offsets_.size(), " columns");
+        }
+    }
+}
+
+std::string LazyFooter::column_name(int i) const {
+    if (i < 0 || i >= num_columns()) {
+        throw parquet::ParquetException("Column index ", i, " out of range for ", num_columns(), " columns");
+    }
+    CompactReader reader(footer_->data(), footer_->size(), leaf_offsets_[i]);
+    int16_t last_id = 0;
+    int16_t id;
+    uint8_t type;
+    while (reader.ReadFieldBegin(&last_id, &id, &type)) {
+        if (id == 4 && type == kBinary) {
+            return reader.ReadString();
+        }
+        reader.Skip(type);
+    }
+    return "";
+}
+
+LazyColumnChunk LazyFooter::ColumnChunk(int row_group, int column) const {
+    if (row_group < 0 || row_group >= num_row_groups()) {
+        throw parquet::ParquetException("Row group ", row_group, " out of range for ", num_row_groups(),
+                                        " row groups");
+    }
+    if (column < 0 || column >= num_columns()) {
+        throw parquet::ParquetException("Column index ", column, " out of range for ", num_columns(), " columns");
+    }
+    CompactReader reader(footer_->data(), footer_->size(), column_offsets_[row_groups_[row_group].first_column + column]);
+
+    LazyColumnChunk chunk;
+    int16_t last_id = 0;
+    int16_t id;
+    uint8_t type;
+    while (reader.ReadFieldBegin(&last_id, &id, &type)) {
+        if (id == 1 && type == kBinary) {
+            chunk.file_path = reader.ReadString();
+        } else if (id == 2 && type == kI64) {
+            chunk.file_offset = reader.ReadI64();
+        } else if (id == 3 && type == kStruct) {
+            DecodeColumnMetaData(reader, &chunk);
+        } else if (id == 4 && type == kI64) {
+            chunk.offset_index_offset = reader.ReadI64();
+        } else if (id == 5 && type == kI32) {
+            chunk.offset_index_length = reader.ReadI32();
+        } else if (id == 6 && type == kI64) {
+            chunk.column_index_offset = reader.ReadI64();
+        } else if (id == 7 && type == kI32) {
+            chunk.column_index_length = reader.ReadI32();
+        } else {
+            reader.Skip(type);
+        }
+    }
+    return chunk;
+}
@@ -0,0 +1,78 @@
+#ifndef LAZY_FOOTER_H
+#define LAZY_FOOTER_H
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+#include <parquet/types.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A column chunk decoded from the Thrift footer.
+struct LazyColumnChunk {
+    std::string file_path;
+    int64_t file_offset = 0;
+    parquet::Type::type type = parquet::Type::UNDEFINED;
+    std::vector<parquet::Encoding::type> encodings;
+    std::vector<std::string> path_in_schema;
+    parquet::Compression::type codec = parquet::Compression::UNCOMPRESSED;
+    int64_t num_values = 0;
+    int64_t total_uncompressed_size = 0;
+    int64_t total_compressed_size = 0;
+    int64_t data_page_offset = 0;
+    int64_t index_page_offset = -1;
+    int64_t dictionary_page_offset = -1;
+    parquet::EncodedStatistics statistics;
+    int64_t offset_index_offset = -1;
+    int32_t offset_index_length = -1;
+    int64_t column_index_offset = -1;
+    int32_t column_index_length = -1;
+};
+
+// Projection-aware view of a Thrift FileMetaData. Make() does a single pass over
+// the compact-protocol bytes that only records where each leaf SchemaElement and
+// each ColumnChunk starts, one offset per column. Column chunks and column names
+// are decoded on request, so a projected read of a wide footer only pays for the
+// columns it touches.
+class LazyFooter {
+public:
+    // `footer` holds the serialized FileMetaData and must outlive the LazyFooter.
+    static arrow::Result<std::shared_ptr<LazyFooter>> Make(std::shared_ptr<arrow::Buffer> footer);
+    // Reads the footer of a Parquet file and calls Make().
+    static arrow::Result<std::shared_ptr<LazyFooter>> Open(std::shared_ptr<arrow::io::RandomAccessFile> file);
+
+    int32_t version() const { return version_; }
+    int64_t num_rows() const { return num_rows_; }
+    int num_columns() const { return static_cast<int>(leaf_offsets_.size()); }
+    int num_row_groups() const { return static_cast<int>(row_groups_.size()); }
+    int64_t row_group_num_rows(int i) const { return row_groups_[i].num_rows; }
+    int64_t row_group_total_byte_size(int i) const { return row_groups_[i].total_byte_size; }
+    int64_t footer_size() const { return footer_->size(); }
+
+    // Decodes the name of leaf column `i`.
+    std::string column_name(int i) const;
+    // Decodes one column chunk. Throws parquet::ParquetException on malformed input.
+    LazyColumnChunk ColumnChunk(int row_group, int column) const;
+
+private:
+    struct RowGroupInfo {
+        int64_t num_rows = 0;
+        int64_t total_byte_size = 0;
+        // Offset of the first ColumnChunk in column_offsets_
+        size_t first_column = 0;
+    };
+
+    explicit LazyFooter(std::shared_ptr<arrow::Buffer> footer) : footer_(std::move(footer)) {}
+    void Scan();
+
+    std::shared_ptr<arrow::Buffer> footer_;
+    int32_t version_ = 0;
+    int64_t num_rows_ = 0;
+    std::vector<uint32_t> leaf_offsets_;
+    std::vector<RowGroupInfo> row_groups_;
+    std::vector<uint32_t> column_offsets_;
+};
+
+#endif  // LAZY_FOOTER_H
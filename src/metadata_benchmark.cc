@@ -3,35 +3,92 @@
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/file_reader.h>
+#include <parquet/page_index.h>
 #include <parquet/statistics.h>
 #include <parquet/arrow/writer.h>
-#include <random>
 #include <chrono>
 #include <fstream>
 #include "metadata_benchmark.h"
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "metadata_cache.h"
+#include "synthetic_data.h"
+
+namespace {
+
+std::unique_ptr<parquet::ParquetFileReader> OpenParquetReader(const std::string& filename,
+                                                              std::shared_ptr<arrow::io::RandomAccessFile> infile,
+                                                              MetadataCache* cache) {
+    if (cache == nullptr) {
+        return parquet::ParquetFileReader::Open(infile, parquet::ReaderProperties(BenchmarkMemoryPool()));
+    }
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    PARQUET_ASSIGN_OR_THROW(metadata, cache->Get(filename, infile));
+    return parquet::ParquetFileReader::Open(infile, parquet::ReaderProperties(BenchmarkMemoryPool()), metadata);
+}
 
-BenchmarkChunksAndPagesResult BenchmarkChunksAndPages(const std::string& filename) {
+}  // namespace
+
+BenchmarkChunksAndPagesResult BenchmarkChunksAndPages(const std::string& filename, MetadataCache* cache) {
     BenchmarkChunksAndPagesResult result;
 
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(filename));
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename));
 
     auto start_total = std::chrono::high_resolution_clock::now();
     
     auto start_thrift = std::chrono::high_resolution_clock::now();
-    std::unique_ptr<parquet::ParquetFileReader> parquet_reader = 
-        parquet::ParquetFileReader::Open(infile);
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader = OpenParquetReader(filename, infile, cache);
     auto end_thrift = std::chrono::high_resolution_clock::now();
 
     auto start_schema = std::chrono::high_resolution_clock::now();
     std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
-    PARQUET_THROW_NOT_OK(parquet::arrow::FileReader::Make(arrow::default_memory_pool(), std::move(parquet_reader), &arrow_reader));
+    PARQUET_THROW_NOT_OK(parquet::arrow::FileReader::Make(BenchmarkMemoryPool(), std::move(parquet_reader), &arrow_reader));
     std::shared_ptr<arrow::Schema> schema;
     PARQUET_THROW_NOT_OK(arrow_reader->GetSchema(&schema));
     auto end_schema = std::chrono::high_resolution_clock::now();
 
     auto end_total = std::chrono::high_resolution_clock::now();
 
+    // The page index lives outside the footer and is decoded on demand, so it is
+    // timed separately from the footer decode.
+    auto* file_reader = arrow_reader->parquet_reader();
+    auto file_metadata = file_reader->metadata();
+    result.page_index_size = 0;
+    for (int r = 0; r < file_metadata->num_row_groups(); ++r) {
+        auto row_group = file_metadata->RowGroup(r);
+        for (int c = 0; c < row_group->num_columns(); ++c) {
+            auto column_chunk = row_group->ColumnChunk(c);
+            if (auto column_index = column_chunk->GetColumnIndexLocation()) {
+                result.page_index_size += column_index->length;
+            }
+            if (auto offset_index = column_chunk->GetOffsetIndexLocation()) {
+                result.page_index_size += offset_index->length;
+            }
+        }
+    }
+
+    result.num_indexed_pages = 0;
+    auto start_page_index = std::chrono::high_resolution_clock::now();
+    if (auto page_index_reader = file_reader->GetPageIndexReader()) {
+        for (int r = 0; r < file_metadata->num_row_groups(); ++r) {
+            auto row_group_index = page_index_reader->RowGroup(r);
+            if (!row_group_index) {
+                continue;
+            }
+            for (int c = 0; c < file_metadata->num_columns(); ++c) {
+                auto column_index = row_group_index->GetColumnIndex(c);
+                auto offset_index = row_group_index->GetOffsetIndex(c);
+                if (column_index && offset_index) {
+                    result.num_indexed_pages += offset_index->page_locations().size();
+                }
+            }
+        }
+    }
+    auto end_page_index = std::chrono::high_resolution_clock::now();
+
+    result.page_index_decode_time = std::chrono::duration<double, std::micro>(end_page_index - start_page_index).count();
     result.total_decode_time = std::chrono::duration<double, std::micro>(end_total - start_total).count();
     result.thrift_decode_time = std::chrono::duration<double, std::micro>(end_thrift - start_thrift).count();
     result.schema_build_time = std::chrono::duration<double, std::micro>(end_schema - start_schema).count();
@@ -41,16 +98,15 @@ BenchmarkChunksAndPagesResult BenchmarkChunksAndPages(const std::string& filenam
     return result;
 }
 
-BenchmarkStatsResult BenchmarkStats(const std::string& filename) {
+BenchmarkStatsResult BenchmarkStats(const std::string& filename, MetadataCache* cache) {
     BenchmarkStatsResult result;
 
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(filename));
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, OpenInputFile(filename));
 
     auto start = std::chrono::high_resolution_clock::now();
     
-    std::unique_ptr<parquet::ParquetFileReader> parquet_reader = 
-        parquet::ParquetFileReader::Open(infile);
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader = OpenParquetReader(filename, infile, cache);
     
     std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
     int num_row_groups = file_metadata->num_row_groups();
@@ -80,54 +136,48 @@ BenchmarkStatsResult BenchmarkStats(const std::string& filename) {
 
 void WriteChunksAndPagesResults(const std::vector<BenchmarkChunksAndPagesResult>& results, const std::string& filename) {
     std::ofstream file(filename);
-    file << "num_columns,total_decode_time_us,thrift_decode_time_us,schema_build_time_us,size_bytes,stats_level\n";
+    file << "num_columns,total_decode_time_us,thrift_decode_time_us,schema_build_time_us,size_bytes,stats_level,"
+         << "page_index_size_bytes,page_index_decode_time_us,num_indexed_pages,cached_total_decode_time_us,"
+         << "cached_thrift_decode_time_us,memory_pool\n";
     for (const auto& result : results) {
         file << result.num_columns << ","
              << result.total_decode_time << ","
              << result.thrift_decode_time << ","
              << result.schema_build_time << ","
              << result.size << ","
-             << static_cast<int>(result.stats_level) << "\n";
+             << static_cast<int>(result.stats_level) << ","
+             << result.page_index_size << ","
+             << result.page_index_decode_time << ","
+             << result.num_indexed_pages << ","
+             << result.cached_total_decode_time << ","
+             << result.cached_thrift_decode_time << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
     }
 }
 
 void WriteStatsBenchmarkResults(const std::vector<BenchmarkStatsResult>& results, const std::string& filename) {
     std::ofstream file(filename);
-    file << "num_columns,num_row_groups,stats_decode_time_us,size_bytes,stats_enabled\n";
+    file << "num_columns,num_row_groups,stats_decode_time_us,size_bytes,stats_enabled,cached_stats_decode_time_us,"
+         << "memory_pool\n";
     for (const auto& result : results) {
         file << result.num_columns << ","
              << result.num_row_groups << ","
              << result.stats_decode_time << ","
              << result.size << ","
-             << (result.stats_enabled ? "true" : "false") << "\n";
+             << (result.stats_enabled ? "true" : "false") << ","
+             << result.cached_stats_decode_time << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << "\n";
     }
 }
 
 arrow::Status WriteCustomParquetFile(int num_columns, int num_rows, const std::string& filename, parquet::Compression::type compression,
-                                     int row_group_size, int page_size, bool enable_statistics) {
-    // Create schema
-    arrow::FieldVector fields;
-    for (int i = 0; i < num_columns; ++i) {
-        fields.push_back(arrow::field("col_" + std::to_string(i), arrow::float32()));
-    }
-    auto schema = arrow::schema(fields);
-
+                                     int row_group_size, int page_size, bool enable_statistics,
+                                     ColumnEncoding encoding) {
     // Create random data
-    std::default_random_engine generator;
-    std::uniform_real_distribution<float> distribution(0.0, 100.0);
-
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
-    for (int i = 0; i < num_columns; ++i) {
-        arrow::FloatBuilder builder;
-        for (int j = 0; j < num_rows; ++j) {
-            ARROW_RETURN_NOT_OK(builder.Append(distribution(generator)));
-        }
-        std::shared_ptr<arrow::Array> array;
-        ARROW_RETURN_NOT_OK(builder.Finish(&array));
-        arrays.push_back(array);
-    }
-
-    auto table = arrow::Table::Make(schema, arrays);
+    ColumnSpec spec;
+    spec.low = 0;
+    spec.high = 100;
+    ARROW_ASSIGN_OR_RAISE(auto table, GenerateTable(num_columns, num_rows, BenchmarkMemoryPool(), spec));
 
     // Open output file
     std::shared_ptr<arrow::io::FileOutputStream> outfile;
@@ -138,11 +188,12 @@ arrow::Status WriteCustomParquetFile(int num_columns, int num_rows, const std::s
     builder.compression(compression)
            ->enable_statistics()
            ->data_pagesize(page_size);
+    SetColumnEncoding(&builder, encoding);
 
     auto properties = builder.build();
 
     // Write the table
-    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), 
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), 
                                                    outfile, row_group_size, properties));
 
     return arrow::Status::OK();
@@ -163,27 +214,31 @@ struct BenchmarkResult {
     double stats_decode_time_ms;
     double file_size_mb;
     bool enable_statistics;
+    ColumnEncoding encoding;
 };
 
-BenchmarkResult RunBenchmarkWithStats(int num_columns, int num_rows, int row_group_size, int page_size, bool enable_statistics) {
+BenchmarkResult RunBenchmarkWithStats(int num_columns, int num_rows, int row_group_size, int page_size, bool enable_statistics,
+                                      ColumnEncoding encoding) {
     BenchmarkResult result;
     result.num_columns = num_columns;
     result.num_rows = num_rows;
     result.row_group_size = row_group_size;
     result.page_size = page_size;
     result.enable_statistics = enable_statistics;
+    result.encoding = encoding;
     result.stats_level = enable_statistics ? StatsLevel::CHUNK : StatsLevel::NONE;
 
     std::string filename = "benchmark_float32_" + std::to_string(num_columns) + 
                            "cols_" + std::to_string(row_group_size) + "rg_" +
                            std::to_string(page_size) + "ps_" +
-                           (enable_statistics ? "stats" : "nostats") + ".parquet";
+                           (enable_statistics ? "stats" : "nostats") + "_" +
+                           ColumnEncodingName(encoding) + ".parquet";
 
     // Write Parquet file
     auto start = std::chrono::high_resolution_clock::now();
     auto status = WriteCustomParquetFile(num_columns, num_rows, filename, 
                                          parquet::Compression::SNAPPY,
-                                         row_group_size, page_size, enable_statistics);
+                                         row_group_size, page_size, enable_statistics, encoding);
     auto end = std::chrono::high_resolution_clock::now();
     result.write_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
 
@@ -213,7 +268,7 @@ BenchmarkResult RunBenchmarkWithStats(int num_columns, int num_rows, int row_gro
 void WriteRowGroupResults(const std::vector<BenchmarkResult>& results, const std::string& filename) {
     std::ofstream file(filename);
     file << "num_columns,num_rows,row_group_size,page_size,stats_level,write_time_ms,total_decode_time_ms,"
-         << "thrift_decode_time_ms,schema_build_time_ms,stats_decode_time_ms,file_size_mb\n";
+         << "thrift_decode_time_ms,schema_build_time_ms,stats_decode_time_ms,file_size_mb,memory_pool,encoding\n";
     for (const auto& result : results) {
         file << result.num_columns << ","
              << result.num_rows << ","
@@ -225,11 +280,18 @@ void WriteRowGroupResults(const std::vector<BenchmarkResult>& results, const std
              << result.thrift_decode_time_ms << ","
              << result.schema_build_time_ms << ","
              << result.stats_decode_time_ms << ","
-             << result.file_size_mb << "\n";
+             << result.file_size_mb << ","
+             << MemoryPoolBackendName(BenchmarkMemoryPoolBackend()) << ","
+             << ColumnEncodingName(result.encoding) << "\n";
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     std::vector<int> column_counts = {10, 100, 1000, 10000};
     std::vector<StatsLevel> stats_levels = {StatsLevel::NONE, StatsLevel::CHUNK, StatsLevel::PAGE};
     int num_rows = 10000;
@@ -255,12 +317,22 @@ int main() {
 
             auto chunks_and_pages_result = BenchmarkChunksAndPages(filename);
             chunks_and_pages_result.stats_level = stats_level;
-            chunks_and_pages_results.push_back(chunks_and_pages_result);
-
             auto stats_result = BenchmarkStats(filename);
             stats_result.stats_enabled = (stats_level != StatsLevel::NONE);
+
+            // The first cached open decodes the footer into the cache, the
+            // timed ones after it take the footer from there
+            auto* cache = MetadataCache::Global();
+            BenchmarkChunksAndPages(filename, cache);
+            auto cached_chunks_and_pages_result = BenchmarkChunksAndPages(filename, cache);
+            chunks_and_pages_result.cached_total_decode_time = cached_chunks_and_pages_result.total_decode_time;
+            chunks_and_pages_result.cached_thrift_decode_time = cached_chunks_and_pages_result.thrift_decode_time;
+            stats_result.cached_stats_decode_time = BenchmarkStats(filename, cache).stats_decode_time;
+
+            chunks_and_pages_results.push_back(chunks_and_pages_result);
             stats_results.push_back(stats_result);
 
+            cache->Invalidate(filename);
             std::remove(filename.c_str());
         }
     }
@@ -269,12 +341,18 @@ int main() {
     std::vector<int> row_group_sizes = {1000, 2000, 5000, 10000};
     std::vector<int> page_sizes = {8 * 1024, 64 * 1024, 1 * 1024 * 1024, 8 * 1024 * 1024};
     std::vector<bool> enable_statistics_options = {false, true};
+    // The float encodings; each changes the pages, and so the footer, written per chunk
+    std::vector<ColumnEncoding> encodings = {ColumnEncoding::PLAIN, ColumnEncoding::DICTIONARY,
+                                             ColumnEncoding::BYTE_STREAM_SPLIT};
 
     for (int num_columns : {10, 100, 1000}) {
         for (int row_group_size : row_group_sizes) {
             for (int page_size : page_sizes) {
                 for (bool enable_statistics : enable_statistics_options) {
-                    row_group_results.push_back(RunBenchmarkWithStats(num_columns, num_rows, row_group_size, page_size, enable_statistics));
+                    for (auto encoding : encodings) {
+                        row_group_results.push_back(RunBenchmarkWithStats(num_columns, num_rows, row_group_size,
+                                                                          page_size, enable_statistics, encoding));
+                    }
                 }
             }
         }
@@ -12,6 +12,13 @@ struct BenchmarkChunksAndPagesResult {
     int64_t size;
     int num_columns;
     StatsLevel stats_level;
+    // ColumnIndex + OffsetIndex bytes, and the time to decode all of them
+    int64_t page_index_size;
+    double page_index_decode_time;
+    int64_t num_indexed_pages;
+    // The same open with the footer taken from a warm MetadataCache
+    double cached_total_decode_time;
+    double cached_thrift_decode_time;
 };
 
 struct BenchmarkStatsResult {
@@ -20,10 +27,15 @@ struct BenchmarkStatsResult {
     int num_columns;
     int num_row_groups;
     bool stats_enabled;
+    // The same walk with the footer taken from a warm MetadataCache
+    double cached_stats_decode_time;
 };
 
-BenchmarkChunksAndPagesResult BenchmarkChunksAndPages(const std::string& filename);
-BenchmarkStatsResult BenchmarkStats(const std::string& filename);
+class MetadataCache;
+
+// With a `cache`, the footer is taken from it instead of being decoded on every open.
+BenchmarkChunksAndPagesResult BenchmarkChunksAndPages(const std::string& filename, MetadataCache* cache = nullptr);
+BenchmarkStatsResult BenchmarkStats(const std::string& filename, MetadataCache* cache = nullptr);
 void WriteChunksAndPagesResults(const std::vector<BenchmarkChunksAndPagesResult>& results, const std::string& filename);
 void WriteStatsBenchmarkResults(const std::vector<BenchmarkStatsResult>& results, const std::string& filename);
 
@@ -0,0 +1,147 @@
+#include "metadata_cache.h"
+#include "benchmark_io.h"
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+
+namespace {
+
+arrow::Status StatFile(const std::string& path, uintmax_t* file_size, int64_t* mtime) {
+    std::error_code ec;
+    *file_size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return arrow::Status::IOError("Cannot stat ", path, ": ", ec.message());
+    }
+    auto last_write_time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return arrow::Status::IOError("Cannot stat ", path, ": ", ec.message());
+    }
+    *mtime = last_write_time.time_since_epoch().count();
+    return arrow::Status::OK();
+}
+
+}  // namespace
+
+MetadataCache* MetadataCache::Global() {
+    static MetadataCache cache;
+    return &cache;
+}
+
+arrow::Result<std::shared_ptr<parquet::FileMetaData>> MetadataCache::Get(
+    const std::string& path, const std::shared_ptr<arrow::io::RandomAccessFile>& file) {
+    uintmax_t file_size;
+    int64_t mtime;
+    ARROW_RETURN_NOT_OK(StatFile(path, &file_size, &mtime));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+            if (it->second->file_size == file_size && it->second->mtime == mtime) {
+                ++hits_;
+                lru_.splice(lru_.begin(), lru_, it->second);
+                return it->second->metadata;
+            }
+            ++invalidations_;
+            Erase(it->second);
+        }
+        ++misses_;
+    }
+
+    // Decode outside the lock so misses on different files do not serialize.
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    PARQUET_CATCH_NOT_OK(metadata = parquet::ReadMetaData(file));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Insert({path, file_size, mtime, metadata});
+    return metadata;
+}
+
+void MetadataCache::Invalidate(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+        ++invalidations_;
+        Erase(it->second);
+    }
+}
+
+void MetadataCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+void MetadataCache::SetCapacity(int64_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_ = capacity_bytes;
+    EvictToCapacity();
+}
+
+MetadataCacheStats MetadataCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MetadataCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.invalidations = invalidations_;
+    stats.evictions = evictions_;
+    stats.entries = static_cast<int64_t>(entries_.size());
+    stats.bytes = bytes_;
+    stats.capacity_bytes = capacity_bytes_;
+    return stats;
+}
+
+void MetadataCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hits_ = 0;
+    misses_ = 0;
+    invalidations_ = 0;
+    evictions_ = 0;
+}
+
+void MetadataCache::Insert(Entry entry) {
+    // Another thread may have decoded the same file while we did.
+    auto existing = entries_.find(entry.path);
+    if (existing != entries_.end()) {
+        Erase(existing->second);
+    }
+    bytes_ += entry.metadata->size();
+    lru_.push_front(std::move(entry));
+    entries_[lru_.front().path] = lru_.begin();
+    EvictToCapacity();
+}
+
+void MetadataCache::EvictToCapacity() {
+    // The entry just inserted is kept even if it alone exceeds the budget.
+    while (bytes_ > capacity_bytes_ && lru_.size() > 1) {
+        ++evictions_;
+        Erase(std::prev(lru_.end()));
+    }
+}
+
+void MetadataCache::Erase(std::list<Entry>::iterator it) {
+    bytes_ -= it->metadata->size();
+    entries_.erase(it->path);
+    lru_.erase(it);
+}
+
+arrow::Status OpenFileWithMetadataCache(const std::string& path, arrow::MemoryPool* pool, MetadataCache* cache,
+                                        std::unique_ptr<parquet::arrow::FileReader>* reader) {
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    ARROW_ASSIGN_OR_RAISE(file, OpenInputFile(path));
+    return OpenFileWithMetadataCache(path, std::move(file), pool, cache, reader);
+}
+
+arrow::Status OpenFileWithMetadataCache(const std::string& path, std::shared_ptr<arrow::io::RandomAccessFile> file,
+                                        arrow::MemoryPool* pool, MetadataCache* cache,
+                                        std::unique_ptr<parquet::arrow::FileReader>* reader) {
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    ARROW_ASSIGN_OR_RAISE(metadata, cache->Get(path, file));
+
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader;
+    PARQUET_CATCH_NOT_OK(parquet_reader = parquet::ParquetFileReader::Open(
+        file, parquet::ReaderProperties(pool), metadata));
+    return parquet::arrow::FileReader::Make(pool, std::move(parquet_reader), reader);
+}
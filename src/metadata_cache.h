@@ -0,0 +1,92 @@
+#ifndef METADATA_CACHE_H
+#define METADATA_CACHE_H
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/metadata.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct MetadataCacheStats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    // Entries dropped because the file's size or mtime changed.
+    int64_t invalidations = 0;
+    int64_t evictions = 0;
+    int64_t entries = 0;
+    // Serialized (Thrift) footer bytes of the cached entries, which the budget
+    // is measured in. The decoded FileMetaData takes several times as much.
+    int64_t bytes = 0;
+    int64_t capacity_bytes = 0;
+
+    double hit_rate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+// Decoded parquet::FileMetaData keyed by path and validated against the file's
+// size and mtime, with LRU eviction once the cached footers exceed the budget.
+// The budget counts serialized footer bytes, FileMetaData::size(), not the
+// memory the decoded footers take. Thread-safe; entries are shared with
+// callers, so eviction never invalidates metadata a reader still holds.
+class MetadataCache {
+public:
+    // 256 MB of serialized footers
+    static constexpr int64_t kDefaultCapacityBytes = 256 << 20;
+
+    explicit MetadataCache(int64_t capacity_bytes = kDefaultCapacityBytes) : capacity_bytes_(capacity_bytes) {}
+
+    // The process-wide cache used by the benchmarks' open paths.
+    static MetadataCache* Global();
+
+    // Returns the metadata of `path`, decoding the footer from `file` on a miss.
+    // `file` must be open on `path`.
+    arrow::Result<std::shared_ptr<parquet::FileMetaData>> Get(const std::string& path,
+                                                              const std::shared_ptr<arrow::io::RandomAccessFile>& file);
+
+    void Invalidate(const std::string& path);
+    void Clear();
+    // Evicts least recently used entries until the cache fits the new budget.
+    void SetCapacity(int64_t capacity_bytes);
+
+    MetadataCacheStats stats() const;
+    void ResetStats();
+
+private:
+    struct Entry {
+        std::string path;
+        uintmax_t file_size;
+        int64_t mtime;
+        std::shared_ptr<parquet::FileMetaData> metadata;
+    };
+
+    void Insert(Entry entry);
+    void EvictToCapacity();
+    void Erase(std::list<Entry>::iterator it);
+
+    mutable std::mutex mutex_;
+    int64_t capacity_bytes_;
+    int64_t bytes_ = 0;
+    // Most recently used first
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+    int64_t hits_ = 0;
+    int64_t misses_ = 0;
+    int64_t invalidations_ = 0;
+    int64_t evictions_ = 0;
+};
+
+// Opens `path` with parquet::arrow::FileReader, taking the footer from `cache`.
+// The file is opened with OpenInputFile, so it follows the benchmark I/O flags,
+// and the Arrow arrays and the page buffers are both allocated from `pool`.
+arrow::Status OpenFileWithMetadataCache(const std::string& path, arrow::MemoryPool* pool, MetadataCache* cache,
+                                        std::unique_ptr<parquet::arrow::FileReader>* reader);
+// The same on a `file` already open on `path`.
+arrow::Status OpenFileWithMetadataCache(const std::string& path, std::shared_ptr<arrow::io::RandomAccessFile> file,
+                                        arrow::MemoryPool* pool, MetadataCache* cache,
+                                        std::unique_ptr<parquet::arrow::FileReader>* reader);
+
+#endif  // METADATA_CACHE_H
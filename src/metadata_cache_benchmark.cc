@@ -0,0 +1,117 @@
+#include "benchmark_flags.h"
+#include "metadata_cache.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "data_generator.h"
+#include <arrow/io/file.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+// Models a query service that keeps reopening a small set of hot files: every
+// iteration opens one of them, builds a parquet::arrow::FileReader and its schema.
+// range(0) selects the footer source: 0 decodes it on every open, 1 uses a
+// MetadataCache large enough for every file, 2 one that only fits half of them.
+
+namespace {
+
+constexpr int kNumHotFiles = 8;
+constexpr int kHotFileColumns = 1000;
+
+std::vector<std::string> hot_files;
+int64_t footer_size = 0;
+MetadataCache cache;
+
+void GenerateHotFiles() {
+    for (int i = 0; i < kNumHotFiles; ++i) {
+        std::string filename = "metadata_cache_hot_" + std::to_string(i) + ".parquet";
+        if (std::ifstream(filename)) {
+            std::cout << "File " << filename << " already exists. Skipping..." << std::endl;
+        } else {
+            PARQUET_THROW_NOT_OK(DataGenerator::WriteParquetFile(kHotFileColumns, 1000, filename, StatsLevel::CHUNK));
+            std::cout << "Generated file: " << filename << std::endl;
+        }
+        hot_files.push_back(filename);
+    }
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(hot_files[0]));
+    footer_size = parquet::ReadMetaData(file)->size();
+}
+
+void BM_HotFileReopen(benchmark::State& state) {
+    int mode = state.range(0);
+    if (state.thread_index() == 0) {
+        cache.Clear();
+        cache.ResetStats();
+        cache.SetCapacity(mode == 2 ? footer_size * kNumHotFiles / 2 : footer_size * kNumHotFiles);
+    }
+
+    std::mt19937 gen(state.thread_index());
+    std::uniform_int_distribution<size_t> pick(0, hot_files.size() - 1);
+    for (auto _ : state) {
+        const auto& path = hot_files[pick(gen)];
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(path));
+        state.ResumeTiming();
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        if (mode == 0) {
+            std::shared_ptr<arrow::io::RandomAccessFile> file;
+            PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(path));
+            PARQUET_THROW_NOT_OK(parquet::arrow::FileReader::Make(
+                BenchmarkMemoryPool(),
+                parquet::ParquetFileReader::Open(file, parquet::ReaderProperties(BenchmarkMemoryPool())), &reader));
+        } else {
+            PARQUET_THROW_NOT_OK(OpenFileWithMetadataCache(path, BenchmarkMemoryPool(), &cache, &reader));
+        }
+        std::shared_ptr<arrow::Schema> schema;
+        PARQUET_THROW_NOT_OK(reader->GetSchema(&schema));
+        benchmark::DoNotOptimize(schema);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // Every thread has left the loop by now, so thread 0 sees the final counts.
+    if (state.thread_index() == 0 && mode != 0) {
+        auto stats = cache.stats();
+        state.counters["Hits"] = stats.hits;
+        state.counters["Misses"] = stats.misses;
+        state.counters["Evictions"] = stats.evictions;
+        state.counters["HitRate"] = stats.hit_rate();
+        state.counters["CachedBytes"] = stats.bytes;
+    }
+}
+BENCHMARK(BM_HotFileReopen)
+    ->Arg(0)->Arg(1)->Arg(2)
+    ->ThreadRange(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    try {
+        GenerateHotFiles();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in GenerateHotFiles: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/column_page.h>
+#include <parquet/column_reader.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/page_index.h>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <iostream>
+
+// Range predicates on a sorted column, answered either by reading whole column
+// chunks or by using the ColumnIndex to find the matching pages and the
+// OffsetIndex to read only those. Both paths decode the sorted `key` column and
+// the `value` column for the matching rows.
+
+namespace {
+
+constexpr char kFilename[] = "page_index_sorted.parquet";
+constexpr int64_t kNumRows = 4'000'000;
+constexpr int64_t kRowGroupSize = 1'000'000;
+constexpr int64_t kPageSize = 64 * 1024;
+
+void GenerateSortedFile() {
+    if (std::ifstream(kFilename)) {
+        std::cout << "File " << kFilename << " already exists. Skipping..." << std::endl;
+        return;
+    }
+    arrow::Int64Builder key_builder;
+    arrow::DoubleBuilder value_builder;
+    PARQUET_THROW_NOT_OK(key_builder.Reserve(kNumRows));
+    PARQUET_THROW_NOT_OK(value_builder.Reserve(kNumRows));
+    for (int64_t i = 0; i < kNumRows; ++i) {
+        key_builder.UnsafeAppend(i);
+        value_builder.UnsafeAppend(i * 0.5);
+    }
+    std::shared_ptr<arrow::Array> keys;
+    std::shared_ptr<arrow::Array> values;
+    PARQUET_THROW_NOT_OK(key_builder.Finish(&keys));
+    PARQUET_THROW_NOT_OK(value_builder.Finish(&values));
+    auto schema = arrow::schema({arrow::field("key", arrow::int64(), false),
+                                 arrow::field("value", arrow::float64(), false)});
+    auto table = arrow::Table::Make(schema, {keys, values});
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(kFilename));
+    parquet::WriterProperties::Builder builder;
+    builder.compression(parquet::Compression::SNAPPY)
+           ->disable_dictionary()
+           ->data_pagesize(kPageSize)
+           ->enable_statistics()
+           ->enable_write_page_index();
+    PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), outfile, kRowGroupSize,
+                                                    builder.build()));
+    PARQUET_THROW_NOT_OK(outfile->Close());
+    std::cout << "Generated file: " << kFilename << std::endl;
+}
+
+struct ScanCounters {
+    int64_t pages_total = 0;
+    int64_t pages_read = 0;
+    int64_t bytes_read = 0;
+    int64_t rows_matched = 0;
+};
+
+// Decodes up to `num_rows` values of a required column after skipping `skip` rows.
+template <typename DType>
+void ReadValues(parquet::ColumnReader* reader, int64_t skip, int64_t num_rows,
+                std::vector<typename DType::c_type>* values) {
+    auto* typed_reader = static_cast<parquet::TypedColumnReader<DType>*>(reader);
+    typed_reader->Skip(skip);
+    values->resize(num_rows);
+    int64_t total_read = 0;
+    while (total_read < num_rows && typed_reader->HasNext()) {
+        int64_t values_read = 0;
+        typed_reader->ReadBatch(num_rows - total_read, nullptr, nullptr, values->data() + total_read, &values_read);
+        total_read += values_read;
+    }
+    values->resize(total_read);
+}
+
+// Reads every page of both columns and filters the decoded keys.
+void FullChunkScan(parquet::ParquetFileReader* reader, int64_t lo, int64_t hi, ScanCounters* counters) {
+    std::vector<int64_t> keys;
+    std::vector<double> values;
+    auto metadata = reader->metadata();
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        auto row_group = reader->RowGroup(rg);
+        int64_t num_rows = metadata->RowGroup(rg)->num_rows();
+        ReadValues<parquet::Int64Type>(row_group->Column(0).get(), 0, num_rows, &keys);
+        ReadValues<parquet::DoubleType>(row_group->Column(1).get(), 0, num_rows, &values);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] >= lo && keys[i] < hi) {
+                ++counters->rows_matched;
+                benchmark::DoNotOptimize(values[i]);
+            }
+        }
+        for (int c = 0; c < 2; ++c) {
+            counters->bytes_read += metadata->RowGroup(rg)->ColumnChunk(c)->total_compressed_size();
+        }
+    }
+}
+
+// Reads the pages of `column` that hold rows [row_begin, row_end) with a single
+// ranged read, and returns a reader positioned at row_begin.
+std::shared_ptr<parquet::ColumnReader> OpenRowRange(parquet::ParquetFileReader* reader,
+                                                    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                                                    int rg, int column, const parquet::OffsetIndex& offset_index,
+                                                    int64_t row_begin, int64_t row_end, int64_t* skip,
+                                                    ScanCounters* counters) {
+    const auto& pages = offset_index.page_locations();
+    int64_t num_rows = reader->metadata()->RowGroup(rg)->num_rows();
+    size_t first = 0;
+    while (first + 1 < pages.size() && pages[first + 1].first_row_index <= row_begin) {
+        ++first;
+    }
+    size_t last = first;
+    while (last + 1 < pages.size() && pages[last + 1].first_row_index < row_end) {
+        ++last;
+    }
+    int64_t offset = pages[first].offset;
+    int64_t length = pages[last].offset + pages[last].compressed_page_size - offset;
+    int64_t end_row = last + 1 < pages.size() ? pages[last + 1].first_row_index : num_rows;
+
+    std::shared_ptr<arrow::Buffer> buffer;
+    PARQUET_ASSIGN_OR_THROW(buffer, file->ReadAt(offset, length));
+    counters->pages_total += pages.size();
+    counters->pages_read += last - first + 1;
+    counters->bytes_read += length;
+
+    auto column_chunk = reader->metadata()->RowGroup(rg)->ColumnChunk(column);
+    auto page_reader = parquet::PageReader::Open(std::make_shared<arrow::io::BufferReader>(buffer),
+                                                 end_row - pages[first].first_row_index,
+                                                 column_chunk->compression(),
+                                                 parquet::ReaderProperties(BenchmarkMemoryPool()));
+    *skip = row_begin - pages[first].first_row_index;
+    return parquet::ColumnReader::Make(reader->metadata()->schema()->Column(column), std::move(page_reader));
+}
+
+// Uses the key column's ColumnIndex to find the matching row range in each row
+// group, then reads only the pages of both columns that cover it.
+void PageIndexScan(parquet::ParquetFileReader* reader, const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                   int64_t lo, int64_t hi, ScanCounters* counters) {
+    std::vector<int64_t> keys;
+    std::vector<double> values;
+    auto metadata = reader->metadata();
+    auto page_index_reader = reader->GetPageIndexReader();
+    if (!page_index_reader) {
+        throw parquet::ParquetException("File has no page index");
+    }
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        auto row_group_index = page_index_reader->RowGroup(rg);
+        auto key_index = std::static_pointer_cast<parquet::Int64ColumnIndex>(row_group_index->GetColumnIndex(0));
+        auto key_offsets = row_group_index->GetOffsetIndex(0);
+        auto value_offsets = row_group_index->GetOffsetIndex(1);
+        const auto& pages = key_offsets->page_locations();
+        int64_t num_rows = metadata->RowGroup(rg)->num_rows();
+
+        int64_t row_begin = -1;
+        int64_t row_end = -1;
+        for (size_t p = 0; p < pages.size(); ++p) {
+            if (key_index->null_pages()[p] || key_index->max_values()[p] < lo || key_index->min_values()[p] >= hi) {
+                continue;
+            }
+            if (row_begin < 0) {
+                row_begin = pages[p].first_row_index;
+            }
+            row_end = p + 1 < pages.size() ? pages[p + 1].first_row_index : num_rows;
+        }
+        if (row_begin < 0) {
+            counters->pages_total += pages.size() + value_offsets->page_locations().size();
+            continue;
+        }
+
+        int64_t skip;
+        auto key_reader = OpenRowRange(reader, file, rg, 0, *key_offsets, row_begin, row_end, &skip, counters);
+        ReadValues<parquet::Int64Type>(key_reader.get(), skip, row_end - row_begin, &keys);
+        auto value_reader = OpenRowRange(reader, file, rg, 1, *value_offsets, row_begin, row_end, &skip, counters);
+        ReadValues<parquet::DoubleType>(value_reader.get(), skip, row_end - row_begin, &values);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] >= lo && keys[i] < hi) {
+                ++counters->rows_matched;
+                benchmark::DoNotOptimize(values[i]);
+            }
+        }
+    }
+}
+
+// range(0) is the predicate's selectivity in parts per 10000, range(1) selects
+// the full-chunk (0) or page-index (1) scan.
+void BM_SortedRangeScan(benchmark::State& state) {
+    int64_t width = kNumRows * state.range(0) / 10000;
+    bool use_page_index = state.range(1) == 1;
+    // A range in the middle of the file, so it may straddle row groups
+    int64_t lo = (kNumRows - width) / 2;
+    int64_t hi = lo + width;
+
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(kFilename));
+    auto reader = parquet::ParquetFileReader::Open(file, parquet::ReaderProperties(BenchmarkMemoryPool()));
+
+    ScanCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(kFilename));
+        state.ResumeTiming();
+        counters = ScanCounters();
+        if (use_page_index) {
+            PageIndexScan(reader.get(), file, lo, hi, &counters);
+        } else {
+            FullChunkScan(reader.get(), lo, hi, &counters);
+        }
+    }
+    if (!use_page_index) {
+        // Every page is read; count them once, outside the timed loop.
+        auto page_index_reader = reader->GetPageIndexReader();
+        for (int rg = 0; rg < reader->metadata()->num_row_groups(); ++rg) {
+            for (int c = 0; c < 2; ++c) {
+                counters.pages_total += page_index_reader->RowGroup(rg)->GetOffsetIndex(c)->page_locations().size();
+            }
+        }
+        counters.pages_read = counters.pages_total;
+    }
+    if (counters.rows_matched != width) {
+        state.SkipWithError("Scan matched the wrong number of rows");
+    }
+    state.counters["PagesTotal"] = counters.pages_total;
+    state.counters["PagesRead"] = counters.pages_read;
+    state.counters["PagesSkipped"] = counters.pages_total - counters.pages_read;
+    state.counters["BytesRead"] = counters.bytes_read;
+    state.counters["RowsMatched"] = counters.rows_matched;
+}
+BENCHMARK(BM_SortedRangeScan)
+    ->ArgsProduct({{1, 10, 100, 1000, 10000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    try {
+        GenerateSortedFile();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in GenerateSortedFile: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -7,6 +7,8 @@
 #include <cstring>
 #include <zlib.h>
 #include <chrono>
+#include <algorithm>
+#include <numeric>
 
 #include <arrow/io/file.h>
 #include <arrow/io/memory.h>
@@ -16,7 +18,13 @@
 #include <parquet/arrow/writer.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/file_reader.h>
+#include "benchmark_flags.h"
 #include "flatbuff_ns_generated.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "flatbuffer_footer.h"
+#include "lazy_footer.h"
+#include "synthetic_data.h"
 #include <benchmark/benchmark.h>
 
 class ParquetFlatbufferWriter {
@@ -26,65 +34,19 @@ public:
 
     void Write() {
         CreateParquetFile();
-        // Removed AppendFlatbuffer() call
     }
 
     std::string GetFilename() const { return filename_; }
 
-    flatbuffers::Offset<parquet2::FileMetaData> ConvertToFlatbuffer(
-        const std::shared_ptr<parquet::FileMetaData>& metadata,
-        flatbuffers::FlatBufferBuilder& builder) {
-        try {
-            auto schema = ConvertSchema(metadata->schema(), builder);
-            // std::cout << "Schema converted successfully" << std::endl;
-            
-            auto row_groups = ConvertRowGroups(metadata, builder);
-            // std::cout << "Row groups converted successfully" << std::endl;
-            
-            auto created_by = builder.CreateString(metadata->created_by());
-            // std::cout << "Created by string created successfully" << std::endl;
-
-            return parquet2::CreateFileMetaData(
-                builder,
-                metadata->version(),
-                schema,
-                metadata->num_rows(),
-                row_groups,
-                0,  // key_value_metadata
-                created_by
-            );
-        } catch (const std::exception& e) {
-            std::cerr << "Error in ConvertToFlatbuffer: " << e.what() << std::endl;
-            throw;
-        }
-    }
-
 private:
     void CreateParquetFile() {
-        // Create schema
-        std::vector<std::shared_ptr<arrow::Field>> fields;
-        for (int i = 0; i < num_columns_; ++i) {
-            fields.push_back(arrow::field("column_" + std::to_string(i), arrow::float64()));
-        }
-        auto schema = arrow::schema(fields);
-
         // Create random data
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(-1000.0, 1000.0);
-
-        std::vector<std::shared_ptr<arrow::Array>> arrays;
-        for (int i = 0; i < num_columns_; ++i) {
-            arrow::FloatBuilder builder;
-            for (int j = 0; j < num_rows_; ++j) {
-                PARQUET_THROW_NOT_OK(builder.Append(static_cast<float>(dis(gen))));
-            }
-            std::shared_ptr<arrow::Array> array;
-            PARQUET_THROW_NOT_OK(builder.Finish(&array));
-            arrays.push_back(array);
-        }
-
-        auto table = arrow::Table::Make(schema, arrays);
+        ColumnSpec spec;
+        spec.type = arrow::float64();
+        SyntheticDataOptions options;
+        options.column_prefix = "column_";
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_ASSIGN_OR_THROW(table, GenerateTable(num_columns_, num_rows_, BenchmarkMemoryPool(), spec, options));
 
         // Write to Parquet
         std::shared_ptr<arrow::io::FileOutputStream> outfile;
@@ -94,81 +56,7 @@ private:
         builder.disable_statistics();
         auto properties = builder.build();
 
-        PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, num_rows_, properties));
-    }
-    
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<parquet2::SchemaElement>>>
-    ConvertSchema(const parquet::SchemaDescriptor* schema, flatbuffers::FlatBufferBuilder& builder) {
-        std::vector<flatbuffers::Offset<parquet2::SchemaElement>> elements;
-        for (int i = 0; i < schema->num_columns(); ++i) {
-            const auto& column = schema->Column(i);
-            try {
-                elements.push_back(parquet2::CreateSchemaElement(
-                    builder,
-                    static_cast<parquet2::Type>(column->physical_type()),
-                    0,  // type_length
-                    parquet2::FieldRepetitionType_REQUIRED,
-                    builder.CreateString(column->name())
-                ));
-            } catch (const std::exception& e) {
-                std::cerr << "Error converting schema element " << i << ": " << e.what() << std::endl;
-                throw;
-            }
-        }
-        return builder.CreateVector(elements);
-    }
-
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<parquet2::RowGroup>>>
-    ConvertRowGroups(const std::shared_ptr<parquet::FileMetaData>& metadata,
-                     flatbuffers::FlatBufferBuilder& builder) {
-        std::vector<flatbuffers::Offset<parquet2::RowGroup>> row_groups;
-        for (int i = 0; i < metadata->num_row_groups(); ++i) {
-            const auto& rg = metadata->RowGroup(i);
-            try {
-                row_groups.push_back(parquet2::CreateRowGroup(
-                    builder,
-                    ConvertColumns(rg.get(), builder),
-                    rg->total_byte_size(),
-                    rg->num_rows()
-                ));
-            } catch (const std::exception& e) {
-                std::cerr << "Error converting row group " << i << ": " << e.what() << std::endl;
-                throw;
-            }
-        }
-        return builder.CreateVector(row_groups);
-    }
-
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<parquet2::ColumnChunk>>>
-    ConvertColumns(const parquet::RowGroupMetaData* rg,
-                   flatbuffers::FlatBufferBuilder& builder) {
-        std::vector<flatbuffers::Offset<parquet2::ColumnChunk>> columns;
-        for (int i = 0; i < rg->num_columns(); ++i) {
-            auto col = rg->ColumnChunk(i);
-            columns.push_back(parquet2::CreateColumnChunk(
-                builder,
-                builder.CreateString(col->file_path()),
-                col->file_offset(),
-                ConvertColumnMetadata(col, builder)
-            ));
-        }
-        return builder.CreateVector(columns);
-    }
-
-    flatbuffers::Offset<parquet2::ColumnMetadata>
-    ConvertColumnMetadata(const std::unique_ptr<parquet::ColumnChunkMetaData>& col,
-                          flatbuffers::FlatBufferBuilder& builder) {
-        return parquet2::CreateColumnMetadata(
-            builder,
-            static_cast<parquet2::Type>(col->type()),
-            builder.CreateVector(std::vector<int8_t>{static_cast<int8_t>(col->encodings()[0])}),
-            builder.CreateVector(std::vector<flatbuffers::Offset<flatbuffers::String>>{}),
-            static_cast<parquet2::CompressionCodec>(col->compression()),
-            col->num_values(),
-            col->total_uncompressed_size(),
-            col->total_compressed_size(),
-            col->data_page_offset()
-        );
+        PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), outfile, num_rows_, properties));
     }
 
     std::string filename_;
@@ -185,46 +73,11 @@ void SetDefaultCounters(benchmark::State& state) {
 void SetMetadataCounter(benchmark::State& state, size_t metadata_size) {
     state.counters["MetadataSize"] = metadata_size;
 }
-//Struct for Storing benchmark data
-struct BenchmarkResult {
-    int num_columns;
-    double thrift_parse_time;
-    double flatbuffer_encode_time;
-    double flatbuffer_parse_time;
-    double combined_parse_time;
-    size_t original_metadata_size;
-    size_t combined_metadata_size;
-    size_t flatbuffer_size;
-    double thrift_parse_time_avg;
-    double flatbuffer_parse_time_avg;
-};
-std::map<int, BenchmarkResult> benchmark_results;
-
 std::shared_ptr<arrow::io::RandomAccessFile> OpenReadableFile(const std::string& filename) {
-    PARQUET_ASSIGN_OR_THROW(auto file, arrow::io::ReadableFile::Open(filename));
+    PARQUET_ASSIGN_OR_THROW(auto file, OpenInputFile(filename));
     return file;
 }
 
-std::string AppendExtension(std::string thrift, std::string ext) {
-    auto append_uleb = [](uint32_t x, std::string* out) {
-        while (true) {
-            int c = x & 0x7F;
-            if ((x >>= 7) == 0) {
-                out->push_back(c);
-                return;
-            } else {
-                out->push_back(c | 0x80);
-            }
-        }
-    };
-    thrift.pop_back();  // remove the trailing 0
-    thrift += "\x08\xFF\xFF\x01";
-    append_uleb(ext.size(), &thrift);
-    thrift += ext;
-    thrift += "\x00";  // add the trailing 0 back
-    return thrift;
-}
-
 void GenerateTestFiles() {
     std::vector<std::pair<int, int>> file_specs = {
         {3000, 10000},
@@ -235,17 +88,30 @@ void GenerateTestFiles() {
         int num_columns = spec.first;
         int num_rows = spec.second;
         std::string filename = "benchmark_float64_" + std::to_string(num_columns) + "cols.parquet";
+        std::string fbfooter_filename = "benchmark_float64_" + std::to_string(num_columns) + "cols_fbfooter.parquet";
         if (std::ifstream(filename)) {
             std::cout << "File " << filename << " already exists. Skipping..." << std::endl;
+        } else {
+            try {
+                ParquetFlatbufferWriter writer(filename, num_columns, num_rows);
+                writer.Write();
+                std::cout << "Generated file: " << filename << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << "Error generating file " << filename << ": " << e.what() << std::endl;
+                continue;
+            }
+        }
+
+        // Same data with the FlatBuffer footer extension, for the open-and-read benchmarks
+        if (std::ifstream(fbfooter_filename)) {
+            std::cout << "File " << fbfooter_filename << " already exists. Skipping..." << std::endl;
             continue;
         }
-        
-        try {
-            ParquetFlatbufferWriter writer(filename, num_columns, num_rows);
-            writer.Write();
-            std::cout << "Generated file: " << filename << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "Error generating file " << filename << ": " << e.what() << std::endl;
+        auto status = RewriteWithFlatbufferFooter(filename, fbfooter_filename);
+        if (status.ok()) {
+            std::cout << "Generated file: " << fbfooter_filename << std::endl;
+        } else {
+            std::cerr << "Error generating file " << fbfooter_filename << ": " << status.ToString() << std::endl;
         }
     }
 }
@@ -257,43 +123,84 @@ static void BM_ParseThrift(benchmark::State& state) {
     
     auto file = OpenReadableFile(filename);
     
-    double total_time = 0;
     for (auto _ : state) {
-        auto start = std::chrono::high_resolution_clock::now();
         std::shared_ptr<parquet::FileMetaData> metadata = parquet::ReadMetaData(file);
-        auto end = std::chrono::high_resolution_clock::now();
-        total_time += std::chrono::duration<double, std::milli>(end - start).count();
         benchmark::DoNotOptimize(metadata);
     }
-    total_time *=  state.iterations();
-    benchmark_results[state.range(0)].num_columns = state.range(0);
-    benchmark_results[state.range(0)].thrift_parse_time = total_time;
-    benchmark_results[state.range(0)].thrift_parse_time_avg = total_time / state.iterations();
     SetDefaultCounters(state);
-    // state.counters["OriginalMetadataSize"] = metadata.size();
 }
 BENCHMARK(BM_ParseThrift)->Arg(3000)->Arg(2000);
 
+// Decodes the footer and then the metadata of a subset of the columns, either
+// eagerly (parquet::ReadMetaData) or lazily (LazyFooter decodes only those chunks)
+static void BM_ProjectedThriftDecode(benchmark::State& state) {
+    std::string filename = state.range(0) == 3000 ? 
+        "benchmark_float64_3000cols.parquet" : 
+        "benchmark_float64_2000cols.parquet";
+    auto file = OpenReadableFile(filename);
+
+    int subset_size = std::min<int>(state.range(1), state.range(0));
+    bool random_access = state.range(2) == 1;
+    bool lazy = state.range(3) == 1;
+
+    std::vector<int> indices(state.range(0));
+    std::iota(indices.begin(), indices.end(), 0);
+    if (random_access) {
+        std::mt19937 g(42);
+        std::shuffle(indices.begin(), indices.end(), g);
+    }
+    indices.resize(subset_size);
+
+    int64_t footer_size = 0;
+    for (auto _ : state) {
+        if (lazy) {
+            std::shared_ptr<LazyFooter> footer;
+            PARQUET_ASSIGN_OR_THROW(footer, LazyFooter::Open(file));
+            for (int idx : indices) {
+                benchmark::DoNotOptimize(footer->column_name(idx));
+                for (int rg = 0; rg < footer->num_row_groups(); ++rg) {
+                    LazyColumnChunk chunk = footer->ColumnChunk(rg, idx);
+                    benchmark::DoNotOptimize(chunk.data_page_offset);
+                }
+            }
+            footer_size = footer->footer_size();
+        } else {
+            std::shared_ptr<parquet::FileMetaData> metadata = parquet::ReadMetaData(file);
+            for (int idx : indices) {
+                benchmark::DoNotOptimize(metadata->schema()->Column(idx)->name());
+                for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+                    auto chunk = metadata->RowGroup(rg)->ColumnChunk(idx);
+                    benchmark::DoNotOptimize(chunk->data_page_offset());
+                }
+            }
+            footer_size = metadata->size();
+        }
+    }
+    state.counters["NumColumns"] = state.range(0);
+    state.counters["SubsetSize"] = subset_size;
+    state.counters["RandomAccess"] = random_access ? 1 : 0;
+    state.counters["Lazy"] = lazy ? 1 : 0;
+    state.counters["FooterSize"] = footer_size;
+}
+BENCHMARK(BM_ProjectedThriftDecode)
+    ->ArgsProduct({{3000, 2000}, {10, 100, 1000, 3000}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
 static void BM_EncodeFlatbuffer(benchmark::State& state) {
     std::string filename = state.range(0) == 3000 ? 
         "benchmark_float64_3000cols.parquet" : 
         "benchmark_float64_2000cols.parquet";
     
-    std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(filename);
+    std::unique_ptr<parquet::ParquetFileReader> reader =
+        parquet::ParquetFileReader::Open(OpenReadableFile(filename), parquet::ReaderProperties(BenchmarkMemoryPool()));
     std::shared_ptr<parquet::FileMetaData> metadata = reader->metadata();
 
-    ParquetFlatbufferWriter writer(filename, state.range(0), 10000);
-
-    double total_time = 0;
     size_t flatbuffer_size = 0;
     for (auto _ : state) {
         try {
-            auto start = std::chrono::high_resolution_clock::now();
             flatbuffers::FlatBufferBuilder builder;
-            auto flatbuffer_metadata = writer.ConvertToFlatbuffer(metadata, builder);
+            auto flatbuffer_metadata = ConvertToFlatbuffer(*metadata, builder);
             builder.Finish(flatbuffer_metadata);
-            auto end = std::chrono::high_resolution_clock::now();
-            total_time += std::chrono::duration<double, std::milli>(end - start).count();
             flatbuffer_size = builder.GetSize();
         } catch (const std::exception& e) {
             std::cerr << "Error in BM_EncodeFlatbuffer: " << e.what() << std::endl;
@@ -301,9 +208,6 @@ static void BM_EncodeFlatbuffer(benchmark::State& state) {
             break;
         }
     }
-    total_time *=  state.iterations();
-    benchmark_results[state.range(0)].flatbuffer_encode_time = total_time;
-    benchmark_results[state.range(0)].flatbuffer_size = flatbuffer_size;
     SetDefaultCounters(state);
     state.counters["FlatBufferSize"] = flatbuffer_size;
 }
@@ -314,25 +218,17 @@ static void BM_ParseFlatbuffer(benchmark::State& state) {
         "benchmark_float64_3000cols.parquet" : 
         "benchmark_float64_2000cols.parquet";
     
-    std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(filename);
+    std::unique_ptr<parquet::ParquetFileReader> reader =
+        parquet::ParquetFileReader::Open(OpenReadableFile(filename), parquet::ReaderProperties(BenchmarkMemoryPool()));
     std::shared_ptr<parquet::FileMetaData> metadata = reader->metadata();
 
-    ParquetFlatbufferWriter writer(filename, state.range(0), 10000);
-    
     flatbuffers::FlatBufferBuilder builder;
-    auto flatbuffer_metadata = writer.ConvertToFlatbuffer(metadata, builder);
+    auto flatbuffer_metadata = ConvertToFlatbuffer(*metadata, builder);
     builder.Finish(flatbuffer_metadata);
-    double total_time = 0;
     for (auto _ : state) {
-        auto start = std::chrono::high_resolution_clock::now();
         auto fmd = parquet2::GetFileMetaData(builder.GetBufferPointer());
-        auto end = std::chrono::high_resolution_clock::now();
-        total_time += std::chrono::duration<double, std::milli>(end - start).count();
         benchmark::DoNotOptimize(fmd->version());
     }
-    total_time *=  state.iterations();
-    benchmark_results[state.range(0)].flatbuffer_parse_time = total_time;
-    benchmark_results[state.range(0)].flatbuffer_parse_time_avg = total_time / state.iterations();
     SetDefaultCounters(state);
 }
 BENCHMARK(BM_ParseFlatbuffer)->Arg(3000)->Arg(2000);
@@ -341,61 +237,27 @@ static void BM_ParseWithExtension(benchmark::State& state) {
     std::string filename = state.range(0) == 3000 ? 
         "benchmark_float64_3000cols.parquet" : 
         "benchmark_float64_2000cols.parquet";
-    
-    // Read the original Parquet file
-    std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(filename);
-    std::shared_ptr<parquet::FileMetaData> parquet_metadata = reader->metadata();
-    
-    // Serialize the original metadata to Thrift
-    std::shared_ptr<arrow::io::BufferOutputStream> out_stream;
-    PARQUET_ASSIGN_OR_THROW(out_stream, arrow::io::BufferOutputStream::Create());
-    parquet_metadata->WriteTo(out_stream.get());
-    
-    std::shared_ptr<arrow::Buffer> buffer;
-    PARQUET_ASSIGN_OR_THROW(buffer, out_stream->Finish());
-    std::string serialized_metadata = buffer->ToString();
-
-    // Create FlatBuffer
-    ParquetFlatbufferWriter writer(filename, state.range(0), 10000);
-    flatbuffers::FlatBufferBuilder builder;
-    auto flatbuffer_metadata = writer.ConvertToFlatbuffer(parquet_metadata, builder);
-    builder.Finish(flatbuffer_metadata);
-
-    // Combine Thrift and FlatBuffer metadata
-    std::string combined_metadata = serialized_metadata;
-    std::string flatbuffer_data(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
-    combined_metadata += flatbuffer_data;
-    
-    // Add separator
-    combined_metadata += "FBUF";
-
-    // Add metadata size (4 bytes) and magic bytes
-    int32_t metadata_size = combined_metadata.size();
-    combined_metadata.append(reinterpret_cast<const char*>(&metadata_size), 4);
-    combined_metadata += "PAR1";
-
-    double total_combined_parse_time = 0.0;
-    int iterations = 0;
+    std::string fbfooter_filename = state.range(0) == 3000 ?
+        "benchmark_float64_3000cols_fbfooter.parquet" :
+        "benchmark_float64_2000cols_fbfooter.parquet";
+
+    // Footer sizes of the original file and of the copy carrying the extension
+    size_t original_metadata_size = parquet::ReadMetaData(OpenReadableFile(filename))->size();
+    auto file = OpenReadableFile(fbfooter_filename);
+    size_t combined_metadata_size = parquet::ReadMetaData(file)->size();
+    size_t flatbuffer_size = 0;
 
     for (auto _ : state) {
         try {
-            auto buffer = std::make_shared<arrow::Buffer>(combined_metadata);
-            auto file = std::make_shared<arrow::io::BufferReader>(buffer);
-
-            auto start = std::chrono::high_resolution_clock::now();
-            
-            // Parse Thrift metadata
+            // Parse Thrift metadata, skipping over the extension field
             std::shared_ptr<parquet::FileMetaData> md = parquet::ReadMetaData(file);
             benchmark::DoNotOptimize(md);
 
-            // Parse FlatBuffer metadata
-            auto fmd = parquet2::GetFileMetaData(flatbuffer_data.data());
-            benchmark::DoNotOptimize(fmd);
-            
-            auto end = std::chrono::high_resolution_clock::now();
-            total_combined_parse_time += std::chrono::duration<double, std::nano>(end - start).count();
-            iterations++;
-
+            // Parse FlatBuffer metadata from the same footer
+            std::shared_ptr<FlatbufferFooter> footer;
+            PARQUET_ASSIGN_OR_THROW(footer, FlatbufferFooter::Open(file));
+            benchmark::DoNotOptimize(footer->metadata()->version());
+            flatbuffer_size = footer->flatbuffer_size();
         } catch (const std::exception& e) {
             std::cerr << "Error parsing combined metadata: " << e.what() << std::endl;
             state.SkipWithError("Parsing failed");
@@ -403,25 +265,10 @@ static void BM_ParseWithExtension(benchmark::State& state) {
         }
     }
 
-    // Only print results once, after all iterations
-    // if (state.iterations() == iterations) {
-    //     std::cout << "Columns: " << state.range(0)
-    //               << ", Original metadata size: " << serialized_metadata.size()
-    //               << ", Combined metadata size: " << combined_metadata.size()
-    //               << ", FlatBuffer size: " << builder.GetSize() << std::endl;
-    //     std::cout << "Average combined parse time: " << (total_combined_parse_time / iterations / 1e6) << " ms" << std::endl;
-    // }
-
-    // Update the benchmark_results map
-    benchmark_results[state.range(0)].num_columns = state.range(0);
-    benchmark_results[state.range(0)].combined_parse_time = total_combined_parse_time / iterations;
-    benchmark_results[state.range(0)].original_metadata_size = serialized_metadata.size();
-    benchmark_results[state.range(0)].combined_metadata_size = combined_metadata.size();
-    benchmark_results[state.range(0)].flatbuffer_size = flatbuffer_data.size();
     SetDefaultCounters(state);
-    state.counters["OriginalMetadataSize"] = serialized_metadata.size();
-    state.counters["CombinedMetadataSize"] = combined_metadata.size();
-    state.counters["FlatBufferSize"] = builder.GetSize();
+    state.counters["OriginalMetadataSize"] = original_metadata_size;
+    state.counters["CombinedMetadataSize"] = combined_metadata_size;
+    state.counters["FlatBufferSize"] = flatbuffer_size;
 }
 BENCHMARK(BM_ParseWithExtension)->Arg(3000)->Arg(2000);
 
@@ -480,15 +327,15 @@ static void BM_ReadPartialData(benchmark::State& state) {
 
         // FlatBuffer parsing and partial read
         auto start_flatbuffer = std::chrono::high_resolution_clock::now();
-        ParquetFlatbufferWriter writer(filename, state.range(0), 10000);
         flatbuffers::FlatBufferBuilder builder;
-        auto flatbuffer_metadata = writer.ConvertToFlatbuffer(metadata, builder);
+        auto flatbuffer_metadata = ConvertToFlatbuffer(*metadata, builder);
         builder.Finish(flatbuffer_metadata);
         flatbuffer_size = builder.GetSize();
         auto fmd = parquet2::GetFileMetaData(builder.GetBufferPointer());
-        for (int i = 0; i < subset_size && i < fmd->schema()->size(); ++i) {
+        // Element 0 of the FlatBuffer schema is the root, so leaf i is element i + 1
+        for (int i = 0; i < subset_size && i < static_cast<int>(fmd->schema()->size()) - 1; ++i) {
             int idx = random_access ? indices[i] : i;
-            std::string column_name = fmd->schema()->Get(idx)->name()->str();
+            std::string column_name = fmd->schema()->Get(idx + 1)->name()->str();
             flatbuffer_columns.push_back(column_name);
             benchmark::DoNotOptimize(column_name);
         }
@@ -506,7 +353,6 @@ static void BM_ReadPartialData(benchmark::State& state) {
     state.counters["RandomAccess"] = random_access ? 1 : 0;
 }
 
-// BENCHMARK calls remain the same
 BENCHMARK(BM_ReadPartialData)
     ->Args({3000, 10, 0})   // 3000 columns, read 10, sequential
     ->Args({3000, 100, 0})  // 3000 columns, read 100, sequential
@@ -526,132 +372,89 @@ BENCHMARK(BM_ReadPartialData)
     ->Args({2000, 2000, 1}) // 2000 columns, read all, random
     ->Unit(benchmark::kNanosecond);
 
-// static void BM_ReadPartialData(benchmark::State& state) {
-//     // Parameters
-//     int num_columns = state.range(0);
-//     int num_row_groups = state.range(1);
-//     int subset_size = state.range(2);
-//     bool random_access = state.range(3) == 1;
-
-//     // Prepare filename
-//     std::string filename = "benchmark_float64_" + std::to_string(num_columns) + "cols_" + 
-//                            std::to_string(num_row_groups) + "rowgroups.parquet";
-
-//     // Create or open the file
-//     std::shared_ptr<arrow::io::RandomAccessFile> file;
-//     try {
-//         file = OpenReadableFile(filename);
-//     } catch (const std::exception& e) {
-//         // If file doesn't exist, create it
-//         ParquetFlatbufferWriter writer(filename, num_columns, num_row_groups);
-//         writer.Write();
-//         file = OpenReadableFile(filename);
-//     }
-
-//     // Parse Thrift metadata
-//     std::shared_ptr<parquet::FileMetaData> thrift_metadata;
-//     try {
-//         thrift_metadata = parquet::ReadMetaData(file);
-//     } catch (const std::exception& e) {
-//         state.SkipWithError(("Failed to read Thrift metadata: " + std::string(e.what())).c_str());
-//         return;
-//     }
-
-//     // Create Flatbuffer representation
-//     flatbuffers::FlatBufferBuilder builder;
-//     ParquetFlatbufferWriter writer(filename, num_columns, num_row_groups);
-//     auto flatbuffer_metadata = writer.ConvertToFlatbuffer(thrift_metadata, builder);
-//     builder.Finish(flatbuffer_metadata);
-//     auto fmd = parquet2::GetFileMetaData(builder.GetBufferPointer());
-
-//     // Prepare random access indices
-//     std::vector<int> column_indices(num_columns);
-//     std::vector<int> row_group_indices(num_row_groups);
-//     std::iota(column_indices.begin(), column_indices.end(), 0);
-//     std::iota(row_group_indices.begin(), row_group_indices.end(), 0);
-//     std::random_device rd;
-//     std::mt19937 g(rd());
-
-//     if (random_access) {
-//         std::shuffle(column_indices.begin(), column_indices.end(), g);
-//         std::shuffle(row_group_indices.begin(), row_group_indices.end(), g);
-//     }
-
-//     for (auto _ : state) {
-//         // Thrift partial read
-//         auto start_thrift = std::chrono::high_resolution_clock::now();
-//         for (int i = 0; i < subset_size && i < num_columns; ++i) {
-//             int col_idx = random_access ? column_indices[i] : i;
-//             benchmark::DoNotOptimize(thrift_metadata->schema()->Column(col_idx)->name());
-//         }
-//         for (int i = 0; i < subset_size && i < num_row_groups; ++i) {
-//             int rg_idx = random_access ? row_group_indices[i] : i;
-//             benchmark::DoNotOptimize(thrift_metadata->RowGroup(rg_idx)->num_rows());
-//         }
-//         auto end_thrift = std::chrono::high_resolution_clock::now();
-
-//         // Flatbuffer partial read
-//         auto start_flatbuffer = std::chrono::high_resolution_clock::now();
-//         for (int i = 0; i < subset_size && i < num_columns; ++i) {
-//             int col_idx = random_access ? column_indices[i] : i;
-//             benchmark::DoNotOptimize(fmd->schema()->Get(col_idx)->name()->str());
-//         }
-//         for (int i = 0; i < subset_size && i < num_row_groups; ++i) {
-//             int rg_idx = random_access ? row_group_indices[i] : i;
-//             benchmark::DoNotOptimize(fmd->row_groups()->Get(rg_idx)->num_rows());
-//         }
-//         auto end_flatbuffer = std::chrono::high_resolution_clock::now();
-
-//         // Calculate durations
-//         auto thrift_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_thrift - start_thrift);
-//         auto flatbuffer_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_flatbuffer - start_flatbuffer);
-
-//         // Record times
-//         state.counters["ThriftTime"] = benchmark::Counter(thrift_duration.count(), benchmark::Counter::kAvgThreads);
-//         state.counters["FlatBufferTime"] = benchmark::Counter(flatbuffer_duration.count(), benchmark::Counter::kAvgThreads);
-//     }
-
-//     // Record metadata sizes
-//     state.counters["ThriftMetadataSize"] = thrift_metadata->size();
-//     state.counters["FlatBufferSize"] = builder.GetSize();
-
-//     // Record test parameters
-//     state.counters["NumColumns"] = num_columns;
-//     state.counters["NumRowGroups"] = num_row_groups;
-//     state.counters["SubsetSize"] = subset_size;
-//     state.counters["RandomAccess"] = random_access ? 1 : 0;
-// }
-
-// // Register the benchmark
-// BENCHMARK(BM_ReadPartialData)
-//     ->Args({1000, 100, 10, 0})   // 1000 columns, 100 row groups, read 10, sequential
-//     ->Args({1000, 100, 10, 1})   // 1000 columns, 100 row groups, read 10, random
-//     ->Args({1000, 100, 100, 0})  // 1000 columns, 100 row groups, read 100, sequential
-//     ->Args({1000, 100, 100, 1})  // 1000 columns, 100 row groups, read 100, random
-//     ->Args({5000, 500, 10, 0})   // 5000 columns, 500 row groups, read 10, sequential
-//     ->Args({5000, 500, 10, 1})   // 5000 columns, 500 row groups, read 10, random
-//     ->Args({5000, 500, 100, 0})  // 5000 columns, 500 row groups, read 100, sequential
-//     ->Args({5000, 500, 100, 1})  // 5000 columns, 500 row groups, read 100, random
-//     ->Unit(benchmark::kNanosecond);
-
-void WriteResultsToCSV(const std::string& filename) {
-    std::ofstream file(filename);
-    file << "NumColumns,ThriftParseTimeNs,FlatbufferEncodeTimeNs,FlatbufferParseTimeNs,CombinedParseTimeNs,OriginalMetadataSize,CombinedMetadataSize,FlatbufferSize,ThriftParseTimeAvgMs,FlatbufferParseTimeAvgMs\n";
-    for (const auto& [num_columns, result] : benchmark_results) {
-        file << result.num_columns << ","
-             << result.thrift_parse_time << ","
-             << result.flatbuffer_encode_time << ","
-             << result.flatbuffer_parse_time << ","
-             << result.combined_parse_time << ","
-             << result.original_metadata_size << ","
-             << result.combined_metadata_size << ","
-             << result.flatbuffer_size << ","
-             << (result.thrift_parse_time_avg * 1e-6) << ","
-             << (result.flatbuffer_parse_time_avg * 1e-6) << "\n";
+std::vector<int> SelectColumns(int num_columns, int subset_size) {
+    // Spread the projection over the whole file rather than reading a prefix
+    std::vector<int> indices;
+    int stride = std::max(1, num_columns / subset_size);
+    for (int i = 0; i < subset_size && i * stride < num_columns; ++i) {
+        indices.push_back(i * stride);
     }
+    return indices;
 }
 
+static void BM_OpenAndReadThriftFooter(benchmark::State& state) {
+    std::string filename = "benchmark_float64_" + std::to_string(state.range(0)) + "cols.parquet";
+    std::vector<int> indices = SelectColumns(state.range(0), state.range(1));
+
+    int64_t rows_read = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+        state.ResumeTiming();
+        auto file = OpenReadableFile(filename);
+
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(file, BenchmarkMemoryPool(), &reader));
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadTable(indices, &table));
+        rows_read = table->num_rows();
+        benchmark::DoNotOptimize(table);
+    }
+    state.counters["NumColumns"] = state.range(0);
+    state.counters["SubsetSize"] = indices.size();
+    state.counters["RowsRead"] = rows_read;
+}
+BENCHMARK(BM_OpenAndReadThriftFooter)
+    ->Args({3000, 1})
+    ->Args({3000, 10})
+    ->Args({3000, 100})
+    ->Args({3000, 1000})
+    ->Args({2000, 1})
+    ->Args({2000, 10})
+    ->Args({2000, 100})
+    ->Args({2000, 1000})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_OpenAndReadFlatbufferFooter(benchmark::State& state) {
+    std::string filename = "benchmark_float64_" + std::to_string(state.range(0)) + "cols_fbfooter.parquet";
+    std::vector<int> indices = SelectColumns(state.range(0), state.range(1));
+
+    int64_t rows_read = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+        state.ResumeTiming();
+        auto file = OpenReadableFile(filename);
+
+        // The reader's schema only holds the projected columns, so read all of them
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(OpenFileWithFlatbufferFooter(file, BenchmarkMemoryPool(), indices, &reader));
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+        rows_read = table->num_rows();
+        benchmark::DoNotOptimize(table);
+    }
+    state.counters["NumColumns"] = state.range(0);
+    state.counters["SubsetSize"] = indices.size();
+    state.counters["RowsRead"] = rows_read;
+}
+BENCHMARK(BM_OpenAndReadFlatbufferFooter)
+    ->Args({3000, 1})
+    ->Args({3000, 10})
+    ->Args({3000, 100})
+    ->Args({3000, 1000})
+    ->Args({2000, 1})
+    ->Args({2000, 10})
+    ->Args({2000, 100})
+    ->Args({2000, 1000})
+    ->Unit(benchmark::kMicrosecond);
+
 int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     try {
         
         GenerateTestFiles();
@@ -661,6 +464,8 @@ int main(int argc, char** argv) {
     }
     
     ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
     try {
         ::benchmark::RunSpecifiedBenchmarks();
     } catch (const std::exception& e) {
@@ -668,8 +473,5 @@ int main(int argc, char** argv) {
         return 1;
     }
     ::benchmark::Shutdown();
-
-    // WriteResultsToCSV("benchmark_flatbuffers.csv");
-
     return 0;
 }
\ No newline at end of file
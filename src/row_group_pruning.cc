@@ -0,0 +1,153 @@
+#include "row_group_pruning.h"
+#include <parquet/exception.h>
+#include <parquet/statistics.h>
+#include <sstream>
+
+namespace {
+
+template <typename StatisticsType>
+void LoadMinMax(const parquet::Statistics& statistics, double* min, double* max) {
+    const auto& typed = static_cast<const StatisticsType&>(statistics);
+    *min = static_cast<double>(typed.min());
+    *max = static_cast<double>(typed.max());
+}
+
+// Returns false if the chunk has no min/max to prune with.
+bool ColumnMinMax(const parquet::ColumnChunkMetaData& column, double* min, double* max) {
+    if (!column.is_stats_set()) {
+        return false;
+    }
+    auto statistics = column.statistics();
+    if (!statistics || !statistics->HasMinMax()) {
+        return false;
+    }
+    switch (column.type()) {
+        case parquet::Type::INT32:
+            LoadMinMax<parquet::Int32Statistics>(*statistics, min, max);
+            return true;
+        case parquet::Type::INT64:
+            LoadMinMax<parquet::Int64Statistics>(*statistics, min, max);
+            return true;
+        case parquet::Type::FLOAT:
+            LoadMinMax<parquet::FloatStatistics>(*statistics, min, max);
+            return true;
+        case parquet::Type::DOUBLE:
+            LoadMinMax<parquet::DoubleStatistics>(*statistics, min, max);
+            return true;
+        default:
+            throw parquet::ParquetException("Column ", column.path_in_schema()->ToDotString(),
+                                            " of type ", parquet::TypeToString(column.type()),
+                                            " is not numeric");
+    }
+}
+
+const char* OpToString(Predicate::Op op) {
+    switch (op) {
+        case Predicate::Op::EQ: return "==";
+        case Predicate::Op::LT: return "<";
+        case Predicate::Op::LE: return "<=";
+        case Predicate::Op::GT: return ">";
+        case Predicate::Op::GE: return ">=";
+    }
+    return "?";
+}
+
+}  // namespace
+
+std::shared_ptr<Predicate> Predicate::Compare(const std::string& column, Op op, double value) {
+    std::shared_ptr<Predicate> predicate(new Predicate(Kind::COMPARE));
+    predicate->column_ = column;
+    predicate->op_ = op;
+    predicate->value_ = value;
+    return predicate;
+}
+
+std::shared_ptr<Predicate> Predicate::Range(const std::string& column, double lo, double hi) {
+    return And({Compare(column, Op::GE, lo), Compare(column, Op::LT, hi)});
+}
+
+std::shared_ptr<Predicate> Predicate::And(std::vector<std::shared_ptr<Predicate>> children) {
+    std::shared_ptr<Predicate> predicate(new Predicate(Kind::AND));
+    predicate->children_ = std::move(children);
+    return predicate;
+}
+
+std::shared_ptr<Predicate> Predicate::Or(std::vector<std::shared_ptr<Predicate>> children) {
+    std::shared_ptr<Predicate> predicate(new Predicate(Kind::OR));
+    predicate->children_ = std::move(children);
+    return predicate;
+}
+
+bool Predicate::MayMatch(double min, double max) const {
+    switch (op_) {
+        case Op::EQ: return min <= value_ && value_ <= max;
+        case Op::LT: return min < value_;
+        case Op::LE: return min <= value_;
+        case Op::GT: return max > value_;
+        case Op::GE: return max >= value_;
+    }
+    return true;
+}
+
+bool Predicate::MayMatch(const parquet::RowGroupMetaData& row_group) const {
+    switch (kind_) {
+        case Kind::AND:
+            for (const auto& child : children_) {
+                if (!child->MayMatch(row_group)) {
+                    return false;
+                }
+            }
+            return true;
+        case Kind::OR:
+            for (const auto& child : children_) {
+                if (child->MayMatch(row_group)) {
+                    return true;
+                }
+            }
+            return children_.empty();
+        case Kind::COMPARE:
+            break;
+    }
+    int column = row_group.schema()->ColumnIndex(column_);
+    if (column < 0) {
+        throw parquet::ParquetException("Unknown column ", column_);
+    }
+    double min;
+    double max;
+    if (!ColumnMinMax(*row_group.ColumnChunk(column), &min, &max)) {
+        return true;
+    }
+    return MayMatch(min, max);
+}
+
+std::string Predicate::ToString() const {
+    if (kind_ == Kind::COMPARE) {
+        std::ostringstream out;
+        out << column_ << " " << OpToString(op_) << " " << value_;
+        return out.str();
+    }
+    std::string result = "(";
+    for (size_t i = 0; i < children_.size(); ++i) {
+        if (i > 0) {
+            result += kind_ == Kind::AND ? " AND " : " OR ";
+        }
+        result += children_[i]->ToString();
+    }
+    return result + ")";
+}
+
+PruningResult PruneRowGroups(const parquet::FileMetaData& metadata, const Predicate& predicate) {
+    PruningResult result;
+    for (int i = 0; i < metadata.num_row_groups(); ++i) {
+        auto row_group = metadata.RowGroup(i);
+        if (predicate.MayMatch(*row_group)) {
+            result.row_groups.push_back(i);
+            continue;
+        }
+        ++result.row_groups_pruned;
+        for (int c = 0; c < row_group->num_columns(); ++c) {
+            result.bytes_avoided += row_group->ColumnChunk(c)->total_compressed_size();
+        }
+    }
+    return result;
+}
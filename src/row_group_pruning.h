@@ -0,0 +1,54 @@
+#ifndef ROW_GROUP_PRUNING_H
+#define ROW_GROUP_PRUNING_H
+
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A filter over numeric leaf columns (INT32, INT64, FLOAT, DOUBLE), built from
+// comparisons combined with AND/OR. Literals are doubles, so integer comparisons
+// are exact up to 2^53.
+class Predicate {
+public:
+    enum class Op { EQ, LT, LE, GT, GE };
+
+    static std::shared_ptr<Predicate> Compare(const std::string& column, Op op, double value);
+    // lo <= column < hi
+    static std::shared_ptr<Predicate> Range(const std::string& column, double lo, double hi);
+    static std::shared_ptr<Predicate> And(std::vector<std::shared_ptr<Predicate>> children);
+    static std::shared_ptr<Predicate> Or(std::vector<std::shared_ptr<Predicate>> children);
+
+    // Whether a row group may hold matching rows, judged from its chunk min/max.
+    // Columns without usable statistics never prune. Throws
+    // parquet::ParquetException for unknown or non-numeric columns.
+    bool MayMatch(const parquet::RowGroupMetaData& row_group) const;
+
+    std::string ToString() const;
+
+private:
+    enum class Kind { COMPARE, AND, OR };
+
+    explicit Predicate(Kind kind) : kind_(kind) {}
+    bool MayMatch(double min, double max) const;
+
+    Kind kind_;
+    std::string column_;
+    Op op_ = Op::EQ;
+    double value_ = 0;
+    std::vector<std::shared_ptr<Predicate>> children_;
+};
+
+struct PruningResult {
+    std::vector<int> row_groups;
+    int row_groups_pruned = 0;
+    // Compressed column chunk bytes of the pruned row groups
+    int64_t bytes_avoided = 0;
+};
+
+// Returns the row groups of `metadata` that `predicate` cannot rule out, ready for
+// parquet::arrow::FileReader::ReadRowGroups.
+PruningResult PruneRowGroups(const parquet::FileMetaData& metadata, const Predicate& predicate);
+
+#endif  // ROW_GROUP_PRUNING_H
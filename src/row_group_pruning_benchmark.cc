@@ -0,0 +1,163 @@
+#include "benchmark_flags.h"
+#include "row_group_pruning.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "synthetic_data.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+// End-to-end latency of a range query on `key`: open the file, evaluate the
+// predicate against row group statistics, read the surviving row groups with
+// FileReader::ReadRowGroups and count the matching rows. Files differ in how
+// sorted `key` is, which decides how much the statistics can prune.
+
+namespace {
+
+constexpr int64_t kNumRows = 2'000'000;
+constexpr int64_t kRowGroupSize = 20'000;
+constexpr int kNumPayloadColumns = 4;
+
+// 0: sorted, 1: sorted but shuffled within windows of 10 row groups, 2: shuffled
+const char* kSortednessNames[] = {"sorted", "clustered", "random"};
+
+std::string SortednessFilename(int sortedness) {
+    return std::string("row_group_pruning_") + kSortednessNames[sortedness] + ".parquet";
+}
+
+void GenerateFile(int sortedness) {
+    std::string filename = SortednessFilename(sortedness);
+    if (std::ifstream(filename)) {
+        std::cout << "File " << filename << " already exists. Skipping..." << std::endl;
+        return;
+    }
+    std::vector<int64_t> keys(kNumRows);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 gen(42);
+    int64_t window = sortedness == 0 ? 1 : sortedness == 1 ? 10 * kRowGroupSize : kNumRows;
+    for (int64_t start = 0; start < kNumRows; start += window) {
+        std::shuffle(keys.begin() + start, keys.begin() + std::min(start + window, kNumRows), gen);
+    }
+
+    arrow::FieldVector fields = {arrow::field("key", arrow::int64(), false)};
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    arrow::Int64Builder key_builder;
+    PARQUET_THROW_NOT_OK(key_builder.AppendValues(keys));
+    arrays.push_back(key_builder.Finish().ValueOrDie());
+    ColumnSpec payload;
+    payload.type = arrow::float64();
+    arrow::ArrayVector payload_arrays;
+    PARQUET_ASSIGN_OR_THROW(payload_arrays, GenerateColumns(kNumPayloadColumns, kNumRows, BenchmarkMemoryPool(), payload));
+    for (int i = 0; i < kNumPayloadColumns; ++i) {
+        fields.push_back(arrow::field("payload_" + std::to_string(i), arrow::float64(), false));
+        arrays.push_back(payload_arrays[i]);
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+
+    std::shared_ptr<arrow::io::FileOutputStream> outfile;
+    PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(filename));
+    parquet::WriterProperties::Builder builder;
+    builder.enable_statistics()->compression(parquet::Compression::SNAPPY);
+    PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table, BenchmarkMemoryPool(), outfile, kRowGroupSize,
+                                                    builder.build()));
+    PARQUET_THROW_NOT_OK(outfile->Close());
+    std::cout << "Generated file: " << filename << std::endl;
+}
+
+int64_t CountMatches(const arrow::Table& table, int64_t lo, int64_t hi) {
+    int64_t matches = 0;
+    for (const auto& chunk : table.GetColumnByName("key")->chunks()) {
+        const auto& keys = static_cast<const arrow::Int64Array&>(*chunk);
+        for (int64_t i = 0; i < keys.length(); ++i) {
+            matches += keys.Value(i) >= lo && keys.Value(i) < hi;
+        }
+    }
+    return matches;
+}
+
+// range(0): selectivity in parts per 10000, range(1): sortedness,
+// range(2): 1 to prune with statistics, 0 to read every row group.
+void BM_RowGroupPruning(benchmark::State& state) {
+    int64_t width = kNumRows * state.range(0) / 10000;
+    std::string filename = SortednessFilename(state.range(1));
+    bool prune = state.range(2) == 1;
+    int64_t lo = (kNumRows - width) / 2;
+    int64_t hi = lo + width;
+    auto predicate = Predicate::Range("key", lo, hi);
+
+    PruningResult pruning;
+    int64_t rows_matched = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(filename));
+        state.ResumeTiming();
+        std::shared_ptr<arrow::io::RandomAccessFile> file;
+        PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(filename));
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(parquet::arrow::FileReader::Make(
+            BenchmarkMemoryPool(),
+                parquet::ParquetFileReader::Open(file, parquet::ReaderProperties(BenchmarkMemoryPool())), &reader));
+
+        auto metadata = reader->parquet_reader()->metadata();
+        if (prune) {
+            pruning = PruneRowGroups(*metadata, *predicate);
+        } else {
+            pruning = PruningResult();
+            pruning.row_groups.resize(metadata->num_row_groups());
+            std::iota(pruning.row_groups.begin(), pruning.row_groups.end(), 0);
+        }
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadRowGroups(pruning.row_groups, &table));
+        rows_matched = CountMatches(*table, lo, hi);
+    }
+    if (rows_matched != width) {
+        state.SkipWithError("Pruned scan lost matching rows");
+    }
+    state.SetLabel(std::string(kSortednessNames[state.range(1)]) + " " + predicate->ToString());
+    state.counters["RowGroupsRead"] = pruning.row_groups.size();
+    state.counters["RowGroupsPruned"] = pruning.row_groups_pruned;
+    state.counters["BytesAvoided"] = pruning.bytes_avoided;
+    state.counters["RowsMatched"] = rows_matched;
+}
+BENCHMARK(BM_RowGroupPruning)
+    ->ArgsProduct({{1, 10, 100, 1000, 5000}, {0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    try {
+        for (int sortedness = 0; sortedness < 3; ++sortedness) {
+            GenerateFile(sortedness);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error generating files: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
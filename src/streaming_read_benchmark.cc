@@ -0,0 +1,174 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "data_generator.h"
+#include <arrow/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+// Streaming reads through FileReader::GetRecordBatchReader, dropping each batch
+// before reading the next, against ReadRowGroups of the same selection into
+// one Table. Sweeps the batch size, the column projection and the row group
+// selection. Each iteration reads through a fresh ProxyMemoryPool, so the
+// PeakPoolMB counter is the most memory the read held at once; TimeToFirstBatch
+// runs from opening the file until the first batch (or the Table) is ready.
+
+namespace {
+
+constexpr char kFilename[] = "streaming_read_benchmark.parquet";
+constexpr int kNumColumns = 100;
+// DataGenerator writes 10000-row row groups, so 50 of them
+constexpr int kNumRows = 500000;
+
+const char* kProjectionNames[] = {"all columns", "10% of columns"};
+const char* kRowGroupNames[] = {"all row groups", "every 4th row group"};
+
+void GenerateFile() {
+    if (std::ifstream(kFilename)) {
+        std::cout << "File " << kFilename << " already exists. Skipping..." << std::endl;
+        return;
+    }
+    PARQUET_THROW_NOT_OK(DataGenerator::WriteParquetFile(kNumColumns, kNumRows, kFilename));
+    std::cout << "Generated file: " << kFilename << std::endl;
+}
+
+std::vector<int> SelectColumns(int64_t projection) {
+    std::vector<int> columns;
+    for (int i = 0; i < kNumColumns; i += projection == 0 ? 1 : 10) {
+        columns.push_back(i);
+    }
+    return columns;
+}
+
+std::vector<int> SelectRowGroups(int num_row_groups, int64_t selection) {
+    std::vector<int> row_groups;
+    for (int i = 0; i < num_row_groups; i += selection == 0 ? 1 : 4) {
+        row_groups.push_back(i);
+    }
+    return row_groups;
+}
+
+std::unique_ptr<parquet::arrow::FileReader> OpenReader(arrow::MemoryPool* pool, int64_t batch_size) {
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, OpenInputFile(kFilename));
+    parquet::ArrowReaderProperties properties;
+    properties.set_batch_size(batch_size);
+    parquet::arrow::FileReaderBuilder builder;
+    PARQUET_THROW_NOT_OK(builder.Open(file, parquet::ReaderProperties(pool)));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_THROW_NOT_OK(builder.memory_pool(pool)->properties(properties)->Build(&reader));
+    return reader;
+}
+
+int NumRowGroups() {
+    return OpenReader(BenchmarkMemoryPool(), parquet::kArrowDefaultBatchSize)
+        ->parquet_reader()->metadata()->num_row_groups();
+}
+
+// Read is called with a fresh pool and returns the number of rows it read.
+template <typename Read>
+void RunReadBenchmark(benchmark::State& state, int64_t num_columns, Read read) {
+    double first_batch_ms = 0;
+    int64_t peak_memory = 0;
+    int64_t rows = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PARQUET_THROW_NOT_OK(PrepareTimedRead(kFilename));
+        state.ResumeTiming();
+        arrow::ProxyMemoryPool pool(BenchmarkMemoryPool());
+        auto start = std::chrono::high_resolution_clock::now();
+        rows = read(&pool, [&]() {
+            first_batch_ms += std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start).count();
+        });
+        peak_memory = std::max(peak_memory, pool.max_memory());
+    }
+    state.SetBytesProcessed(state.iterations() * rows * num_columns * static_cast<int64_t>(sizeof(float)));
+    state.counters["Rows"] = rows;
+    state.counters["TimeToFirstBatchMs"] = state.iterations() > 0 ? first_batch_ms / state.iterations() : 0;
+    state.counters["PeakPoolMB"] = peak_memory / (1024.0 * 1024.0);
+}
+
+// range(0): batch size, range(1): projection (see kProjectionNames),
+// range(2): row group selection (see kRowGroupNames).
+void BM_StreamingRead(benchmark::State& state) {
+    int64_t batch_size = state.range(0);
+    auto columns = SelectColumns(state.range(1));
+    auto row_groups = SelectRowGroups(NumRowGroups(), state.range(2));
+    RunReadBenchmark(state, columns.size(), [&](arrow::MemoryPool* pool, auto on_first_batch) {
+        auto reader = OpenReader(pool, batch_size);
+        std::shared_ptr<arrow::RecordBatchReader> batch_reader;
+        PARQUET_THROW_NOT_OK(reader->GetRecordBatchReader(row_groups, columns, &batch_reader));
+        int64_t rows = 0;
+        std::shared_ptr<arrow::RecordBatch> batch;
+        while (true) {
+            PARQUET_THROW_NOT_OK(batch_reader->ReadNext(&batch));
+            if (!batch) {
+                break;
+            }
+            if (rows == 0) {
+                on_first_batch();
+            }
+            rows += batch->num_rows();
+            benchmark::DoNotOptimize(batch);
+            batch.reset();
+        }
+        return rows;
+    });
+    state.SetLabel(std::string(kProjectionNames[state.range(1)]) + ", " + kRowGroupNames[state.range(2)]);
+}
+BENCHMARK(BM_StreamingRead)
+    ->ArgsProduct({{1024, 8192, 65536, 1 << 20}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// The same selections read into one Table; range(0) and range(1) are those
+// of BM_StreamingRead's range(1) and range(2).
+void BM_ReadTable(benchmark::State& state) {
+    auto columns = SelectColumns(state.range(0));
+    auto row_groups = SelectRowGroups(NumRowGroups(), state.range(1));
+    RunReadBenchmark(state, columns.size(), [&](arrow::MemoryPool* pool, auto on_first_batch) {
+        auto reader = OpenReader(pool, parquet::kArrowDefaultBatchSize);
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadRowGroups(row_groups, columns, &table));
+        on_first_batch();
+        benchmark::DoNotOptimize(table);
+        return table->num_rows();
+    });
+    state.SetLabel(std::string(kProjectionNames[state.range(0)]) + ", " + kRowGroupNames[state.range(1)]);
+}
+BENCHMARK(BM_ReadTable)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+    try {
+        GenerateFile();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in GenerateFile: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    ::benchmark::AddCustomContext("page_cache", CacheModeName(ColdCacheMode()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    return 0;
+}
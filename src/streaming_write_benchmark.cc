@@ -0,0 +1,157 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
+#include "data_generator.h"
+#include "streaming_writer.h"
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/util/thread_pool.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+// parquet::arrow::WriteTable of a whole in-memory Table, as the data generators
+// write, against WriteParquetStream of the same columns generated batch by
+// batch, with the column chunks of each row group encoded and compressed in
+// parallel. Sweeps the column count, the CPU thread pool size and the writer's
+// memory cap. Generating the data is not timed on either path. Each iteration
+// allocates from a fresh ProxyMemoryPool, so PeakPoolMB counts the input as well
+// as the writer: the whole Table for WriteTable, one batch and the open row
+// group for the streaming writer.
+
+namespace {
+
+constexpr char kFilename[] = "streaming_write_benchmark.parquet";
+// Every file holds the same number of values, however wide
+constexpr int64_t kNumValues = 20000000;
+constexpr int64_t kBatchSize = 1024;
+
+int64_t NumRows(int64_t num_columns) {
+    return kNumValues / num_columns;
+}
+
+// SNAPPY, as the ingest jobs write, in DataGenerator's 10000-row row groups.
+// Without dictionaries: random floats barely repeat, and the streaming writer
+// keeps every column's dictionary of the open row group at once, tens of KB
+// each, which for 10000 columns outweighs all the data it buffers.
+std::shared_ptr<parquet::WriterProperties> WriterProperties() {
+    return parquet::WriterProperties::Builder(*DataGenerator::WriterProperties(StatsLevel::CHUNK))
+        .compression(parquet::Compression::SNAPPY)
+        ->disable_dictionary()
+        ->build();
+}
+
+// Stops the benchmark timer while the wrapped reader generates a batch.
+class UntimedBatchReader : public arrow::RecordBatchReader {
+public:
+    UntimedBatchReader(std::shared_ptr<arrow::RecordBatchReader> reader, benchmark::State* state)
+        : reader_(std::move(reader)), state_(state) {}
+
+    std::shared_ptr<arrow::Schema> schema() const override { return reader_->schema(); }
+
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+        state_->PauseTiming();
+        auto status = reader_->ReadNext(batch);
+        state_->ResumeTiming();
+        return status;
+    }
+
+private:
+    std::shared_ptr<arrow::RecordBatchReader> reader_;
+    benchmark::State* state_;
+};
+
+void SetCounters(benchmark::State& state, int64_t num_columns, int64_t peak_memory, int64_t num_row_groups) {
+    state.SetBytesProcessed(state.iterations() * kNumValues * static_cast<int64_t>(sizeof(float)));
+    state.counters["PeakPoolMB"] = peak_memory / (1024.0 * 1024.0);
+    state.counters["RowGroups"] = num_row_groups;
+    state.counters["Rows"] = NumRows(num_columns);
+}
+
+// range(0): number of columns.
+void BM_WriteTable(benchmark::State& state) {
+    int64_t num_columns = state.range(0);
+    auto properties = WriterProperties();
+    int64_t peak_memory = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        arrow::ProxyMemoryPool pool(BenchmarkMemoryPool());
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_ASSIGN_OR_THROW(table, DataGenerator::MakeBatchReader(num_columns, NumRows(num_columns),
+                                                                      NumRows(num_columns), &pool)->ToTable());
+        state.ResumeTiming();
+
+        std::shared_ptr<arrow::io::FileOutputStream> outfile;
+        PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(kFilename));
+        PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(
+            *table, &pool, outfile, properties->max_row_group_length(),
+            parquet::WriterProperties::Builder(*properties).memory_pool(&pool)->build()));
+        PARQUET_THROW_NOT_OK(outfile->Close());
+        peak_memory = std::max(peak_memory, pool.max_memory());
+    }
+    int64_t row_group_length = properties->max_row_group_length();
+    SetCounters(state, num_columns, peak_memory, (NumRows(num_columns) + row_group_length - 1) / row_group_length);
+}
+BENCHMARK(BM_WriteTable)
+    ->Arg(100)->Arg(1000)->Arg(10000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// range(0): number of columns, range(1): CPU thread pool size, with 1 writing
+// the columns serially, range(2): writer memory cap in MB, 0 for none.
+void BM_StreamingWrite(benchmark::State& state) {
+    int64_t num_columns = state.range(0);
+    int threads = state.range(1);
+    StreamingWriteOptions options;
+    options.use_threads = threads > 1;
+    options.memory_cap_bytes = state.range(2) * 1024 * 1024;
+    ThreadPoolCapacityRestorer restorer;
+    PARQUET_THROW_NOT_OK(arrow::SetCpuThreadPoolCapacity(threads));
+
+    auto properties = WriterProperties();
+    int64_t peak_memory = 0;
+    int64_t peak_writer_bytes = 0;
+    StreamingWriteStats stats;
+    for (auto _ : state) {
+        arrow::ProxyMemoryPool pool(BenchmarkMemoryPool());
+        UntimedBatchReader batches(DataGenerator::MakeBatchReader(num_columns, NumRows(num_columns), kBatchSize, &pool),
+                                   &state);
+        std::shared_ptr<arrow::io::FileOutputStream> outfile;
+        PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(kFilename));
+        PARQUET_ASSIGN_OR_THROW(stats, WriteParquetStream(&batches, &pool, outfile, *properties, options));
+        PARQUET_THROW_NOT_OK(outfile->Close());
+        peak_memory = std::max(peak_memory, pool.max_memory());
+        peak_writer_bytes = std::max(peak_writer_bytes, stats.peak_writer_bytes);
+    }
+    SetCounters(state, num_columns, peak_memory, stats.num_row_groups);
+    state.counters["PeakWriterMB"] = peak_writer_bytes / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_StreamingWrite)
+    ->ArgsProduct({{100, 1000, 10000}, {1, 2, 4, 8}, {0, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::AddCustomContext("memory_pool", MemoryPoolBackendName(BenchmarkMemoryPoolBackend()));
+    try {
+        ::benchmark::RunSpecifiedBenchmarks();
+    } catch (const std::exception& e) {
+        std::cerr << "Error during benchmarking: " << e.what() << std::endl;
+        return 1;
+    }
+    ::benchmark::Shutdown();
+    std::remove(kFilename);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include "streaming_writer.h"
+#include <parquet/arrow/writer.h>
+#include <parquet/metadata.h>
+
+arrow::Result<StreamingWriteStats> WriteParquetStream(arrow::RecordBatchReader* batches, arrow::MemoryPool* pool,
+                                                      std::shared_ptr<arrow::io::OutputStream> sink,
+                                                      const parquet::WriterProperties& properties,
+                                                      const StreamingWriteOptions& options) {
+    // The writer's own view of the pool, so the cap leaves out the batches
+    arrow::ProxyMemoryPool writer_pool(pool);
+    auto writer_properties = parquet::WriterProperties::Builder(properties).memory_pool(&writer_pool)->build();
+    auto arrow_properties = parquet::ArrowWriterProperties::Builder().set_use_threads(options.use_threads)->build();
+    ARROW_ASSIGN_OR_RAISE(auto writer, parquet::arrow::FileWriter::Open(*batches->schema(), &writer_pool, sink,
+                                                                        writer_properties, arrow_properties));
+
+    StreamingWriteStats stats;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        ARROW_RETURN_NOT_OK(batches->ReadNext(&batch));
+        if (!batch) {
+            break;
+        }
+        ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
+        ++stats.num_batches;
+        stats.num_rows += batch->num_rows();
+        batch.reset();
+        if (options.memory_cap_bytes > 0 && writer_pool.bytes_allocated() >= options.memory_cap_bytes) {
+            ARROW_RETURN_NOT_OK(writer->NewBufferedRowGroup());
+        }
+    }
+    ARROW_RETURN_NOT_OK(writer->Close());
+    stats.num_row_groups = writer->metadata()->num_row_groups();
+    stats.peak_writer_bytes = writer_pool.max_memory();
+    return stats;
+}
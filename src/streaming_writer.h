@@ -0,0 +1,42 @@
+#ifndef STREAMING_WRITER_H
+#define STREAMING_WRITER_H
+
+#include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/result.h>
+#include <parquet/properties.h>
+#include <cstdint>
+#include <memory>
+
+struct StreamingWriteOptions {
+    // Encode and compress the column chunks of each row group in parallel on
+    // the CPU thread pool
+    bool use_threads = false;
+    // Flush the buffered row group once the writer holds this many bytes, 0 to
+    // flush only at WriterProperties::max_row_group_length. The check runs
+    // after each batch, so the writer may hold up to one batch's worth more.
+    int64_t memory_cap_bytes = 0;
+};
+
+struct StreamingWriteStats {
+    int64_t num_batches = 0;
+    int64_t num_rows = 0;
+    int64_t num_row_groups = 0;
+    // Most bytes the writer held at once, not counting the batches themselves
+    int64_t peak_writer_bytes = 0;
+};
+
+// Writes every batch of `batches` to `sink` through a parquet::arrow::FileWriter
+// in buffered row group mode, so only the open row group is held in memory
+// rather than the whole input, as parquet::arrow::WriteTable needs. The writer
+// allocates from `pool`, including the encoded pages of the open row group,
+// overriding the pool in `properties`. Every column of the open row group has
+// its encoder live at once, so with dictionary encoding the writer holds a
+// dictionary per column however low the memory cap. Does not close `sink`.
+arrow::Result<StreamingWriteStats> WriteParquetStream(arrow::RecordBatchReader* batches, arrow::MemoryPool* pool,
+                                                      std::shared_ptr<arrow::io::OutputStream> sink,
+                                                      const parquet::WriterProperties& properties,
+                                                      const StreamingWriteOptions& options);
+
+#endif  // STREAMING_WRITER_H
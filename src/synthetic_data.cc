@@ -0,0 +1,169 @@
+#include "synthetic_data.h"
+#include <arrow/util/parallel.h>
+#include <chrono>
+#include <mutex>
+
+namespace {
+
+std::mutex synthetic_data_mutex;
+uint64_t synthetic_data_seed = 42;
+GenerationStats generation_totals;
+// The widest range NextBelow draws from, 2^32
+constexpr double kMaxRange = 4294967296.0;
+
+// SplitMix64: one add and three multiply-xorshifts per value, far cheaper
+// than std::mt19937 behind a distribution, and good enough for benchmark data
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+    uint64_t Next() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // In [0, 1), from the top bits
+    float NextFloat() { return static_cast<float>(Next() >> 40) * 0x1.0p-24f; }
+    double NextDouble() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+    // In [0, range), for range up to kMaxRange
+    uint64_t NextBelow(uint64_t range) { return ((Next() >> 32) * range) >> 32; }
+
+private:
+    uint64_t state_;
+};
+
+template <typename T, typename Fill>
+arrow::Result<std::shared_ptr<arrow::Array>> FillColumn(const std::shared_ptr<arrow::DataType>& type,
+                                                        int64_t num_rows, arrow::MemoryPool* pool, Fill fill) {
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> values,
+                          arrow::AllocateBuffer(num_rows * static_cast<int64_t>(sizeof(T)), pool));
+    T* out = reinterpret_cast<T*>(values->mutable_data());
+    for (int64_t i = 0; i < num_rows; ++i) {
+        out[i] = fill();
+    }
+    return arrow::MakeArray(arrow::ArrayData::Make(type, num_rows, {nullptr, std::move(values)}, 0));
+}
+
+}  // namespace
+
+uint64_t SyntheticDataSeed() {
+    std::lock_guard<std::mutex> lock(synthetic_data_mutex);
+    return synthetic_data_seed;
+}
+
+void SetSyntheticDataSeed(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(synthetic_data_mutex);
+    synthetic_data_seed = seed;
+}
+
+uint64_t MixSeed(uint64_t seed, uint64_t index) {
+    return SplitMix64(seed ^ SplitMix64(index).Next()).Next();
+}
+
+arrow::Result<std::shared_ptr<arrow::Array>> GenerateColumn(const ColumnSpec& spec, int64_t num_rows, uint64_t seed,
+                                                            arrow::MemoryPool* pool) {
+    SplitMix64 gen(seed);
+    bool increasing = spec.distribution == ValueDistribution::INCREASING;
+    switch (spec.type->id()) {
+        case arrow::Type::FLOAT: {
+            if (increasing) {
+                break;
+            }
+            float low = static_cast<float>(spec.low);
+            float range = static_cast<float>(spec.high - spec.low);
+            return FillColumn<float>(spec.type, num_rows, pool, [&] { return low + range * gen.NextFloat(); });
+        }
+        case arrow::Type::DOUBLE: {
+            if (increasing) {
+                break;
+            }
+            double range = spec.high - spec.low;
+            return FillColumn<double>(spec.type, num_rows, pool, [&] { return spec.low + range * gen.NextDouble(); });
+        }
+        case arrow::Type::INT64: {
+            auto value = static_cast<int64_t>(spec.low);
+            // NextBelow takes 32-bit ranges only
+            double range = increasing ? spec.high + 1 : spec.high - spec.low;
+            if (!(range > 0 && range <= kMaxRange)) {
+                return arrow::Status::Invalid("int64 columns need ", increasing ? "steps" : "high - low",
+                                              " in (0, 2^32], got ", range);
+            }
+            auto bound = static_cast<uint64_t>(range);
+            if (increasing) {
+                return FillColumn<int64_t>(spec.type, num_rows, pool, [&] { return value += gen.NextBelow(bound); });
+            }
+            return FillColumn<int64_t>(spec.type, num_rows, pool, [&] { return value + gen.NextBelow(bound); });
+        }
+        default:
+            return arrow::Status::NotImplemented("Cannot generate ", spec.type->ToString(), " columns");
+    }
+    return arrow::Status::Invalid("Increasing ", spec.type->ToString(), " columns are not supported");
+}
+
+arrow::Result<arrow::ArrayVector> GenerateColumns(int num_columns, int64_t num_rows, arrow::MemoryPool* pool,
+                                                  const ColumnSpec& spec, const SyntheticDataOptions& options) {
+    auto start = std::chrono::high_resolution_clock::now();
+    arrow::ArrayVector arrays(num_columns);
+    ARROW_RETURN_NOT_OK(arrow::internal::OptionalParallelFor(options.use_threads, num_columns, [&](int i) {
+        return GenerateColumn(spec, num_rows, MixSeed(options.seed, i), pool).Value(&arrays[i]);
+    }));
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::lock_guard<std::mutex> lock(synthetic_data_mutex);
+    generation_totals.bytes += static_cast<int64_t>(num_columns) * num_rows * spec.type->byte_width();
+    generation_totals.seconds += std::chrono::duration<double>(end - start).count();
+    return arrays;
+}
+
+std::shared_ptr<arrow::Schema> SyntheticSchema(int num_columns, const ColumnSpec& spec,
+                                               const SyntheticDataOptions& options) {
+    arrow::FieldVector fields;
+    for (int i = 0; i < num_columns; ++i) {
+        fields.push_back(arrow::field(options.column_prefix + std::to_string(i), spec.type));
+    }
+    return arrow::schema(fields);
+}
+
+arrow::Result<std::shared_ptr<arrow::Table>> GenerateTable(int num_columns, int64_t num_rows, arrow::MemoryPool* pool,
+                                                           const ColumnSpec& spec,
+                                                           const SyntheticDataOptions& options) {
+    ARROW_ASSIGN_OR_RAISE(auto arrays, GenerateColumns(num_columns, num_rows, pool, spec, options));
+    return arrow::Table::Make(SyntheticSchema(num_columns, spec, options), arrays, num_rows);
+}
+
+GenerationStats TotalGenerationStats() {
+    std::lock_guard<std::mutex> lock(synthetic_data_mutex);
+    return generation_totals;
+}
+
+void PrintGenerationStats(std::ostream& out) {
+    auto stats = TotalGenerationStats();
+    if (stats.bytes == 0) {
+        return;
+    }
+    double mb = stats.bytes / (1024.0 * 1024.0);
+    out << "Generated " << mb << " MB of synthetic data in " << stats.seconds * 1000 << " ms ("
+        << (stats.seconds > 0 ? mb / stats.seconds : 0) << " MB/s, seed " << SyntheticDataSeed() << ")"
+        << std::endl;
+}
+
+arrow::Status ParseSyntheticDataFlags(int* argc, char** argv) {
+    const std::string prefix = "--seed=";
+    int kept = 1;
+    for (int i = 1; i < *argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) {
+            try {
+                SetSyntheticDataSeed(std::stoull(arg.substr(prefix.size())));
+            } catch (const std::exception&) {
+                return arrow::Status::Invalid("Invalid seed '", arg.substr(prefix.size()), "'");
+            }
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    *argc = kept;
+    return arrow::Status::OK();
+}
@@ -0,0 +1,73 @@
+#ifndef SYNTHETIC_DATA_H
+#define SYNTHETIC_DATA_H
+
+#include <arrow/api.h>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// How the values of a synthetic column are drawn.
+enum class ValueDistribution {
+    // Uniform between low and high
+    UNIFORM,
+    // From low upwards by uniform integer steps in [0, high], as timestamps
+    // and ids grow; integer columns only
+    INCREASING,
+};
+
+// The values of every column of a generated table; float32, float64 or int64.
+// int64 columns take ranges (or steps) of at most 2^32.
+struct ColumnSpec {
+    std::shared_ptr<arrow::DataType> type = arrow::float32();
+    ValueDistribution distribution = ValueDistribution::UNIFORM;
+    double low = -1000;
+    double high = 1000;
+};
+
+// The seed generated tables use unless given one, 42 until set with --seed.
+uint64_t SyntheticDataSeed();
+void SetSyntheticDataSeed(uint64_t seed);
+
+struct SyntheticDataOptions {
+    // Column i of every table generated from the same seed holds the same
+    // values, whatever the thread count
+    uint64_t seed = SyntheticDataSeed();
+    // Generates the columns in parallel on Arrow's CPU thread pool
+    bool use_threads = true;
+    // Column i is named column_prefix + i
+    std::string column_prefix = "col_";
+};
+
+// A seed derived from `seed` and `index`, for a column or a batch.
+uint64_t MixSeed(uint64_t seed, uint64_t index);
+
+// Fills one buffer with `num_rows` values in place, with no per-value
+// builder calls and no nulls.
+arrow::Result<std::shared_ptr<arrow::Array>> GenerateColumn(const ColumnSpec& spec, int64_t num_rows, uint64_t seed,
+                                                            arrow::MemoryPool* pool);
+arrow::Result<arrow::ArrayVector> GenerateColumns(int num_columns, int64_t num_rows, arrow::MemoryPool* pool,
+                                                  const ColumnSpec& spec = {},
+                                                  const SyntheticDataOptions& options = {});
+std::shared_ptr<arrow::Schema> SyntheticSchema(int num_columns, const ColumnSpec& spec = {},
+                                               const SyntheticDataOptions& options = {});
+arrow::Result<std::shared_ptr<arrow::Table>> GenerateTable(int num_columns, int64_t num_rows, arrow::MemoryPool* pool,
+                                                           const ColumnSpec& spec = {},
+                                                           const SyntheticDataOptions& options = {});
+
+// Totals over every GenerateColumns call in the process.
+struct GenerationStats {
+    int64_t bytes = 0;
+    double seconds = 0;
+};
+
+GenerationStats TotalGenerationStats();
+// One line with the bytes generated and the rate, or nothing if none were.
+// ParseBenchmarkFlags prints it to stderr at exit, so JSON output on stdout
+// stays parseable.
+void PrintGenerationStats(std::ostream& out);
+
+// Handles --seed=<n> and removes it from argv, as ParseMemoryPoolFlags does
+// for --pool.
+arrow::Status ParseSyntheticDataFlags(int* argc, char** argv);
+
+#endif  // SYNTHETIC_DATA_H
@@ -1,14 +1,17 @@
+#include "benchmark_flags.h"
+#include "benchmark_io.h"
+#include "benchmark_memory.h"
 #include <arrow/api.h>
 #include <parquet/arrow/reader.h>
 #include <arrow/io/file.h>
 #include <iostream>
 
 arrow::Status ReadParquetFile(const std::string& filename) {
-    arrow::MemoryPool* pool = arrow::default_memory_pool();
+    arrow::MemoryPool* pool = BenchmarkMemoryPool();
 
     // Open the Parquet file
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROW_ASSIGN_OR_RAISE(infile, arrow::io::ReadableFile::Open(filename));
+    std::shared_ptr<arrow::io::RandomAccessFile> infile;
+    ARROW_ASSIGN_OR_RAISE(infile, OpenInputFile(filename));
 
     // Open the Parquet file reader
     std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
@@ -36,7 +39,12 @@ arrow::Status ReadParquetFile(const std::string& filename) {
     return arrow::Status::OK();
 }
 
-int main() {
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     std::string filename = "./temp/benchmark_float32_10cols.parquet";  // Replace with the desired filename
 
     auto status = ReadParquetFile(filename);
@@ -1,35 +1,17 @@
+#include "benchmark_flags.h"
+#include "benchmark_memory.h"
+#include "synthetic_data.h"
 #include <arrow/api.h>
 #include <parquet/arrow/writer.h>
 #include <arrow/io/file.h>
-#include <random>
 #include <vector>
 #include <iostream>
 
 arrow::Status WriteParquetFile(int num_columns, int num_rows, const std::string& filename) {
-    arrow::MemoryPool* pool = arrow::default_memory_pool();
-    std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    arrow::MemoryPool* pool = BenchmarkMemoryPool();
 
     // Create schema and data for each column
-    for (int i = 0; i < num_columns; ++i) {
-        schema_vector.push_back(arrow::field("col_" + std::to_string(i), arrow::float32()));
-
-        arrow::FloatBuilder builder(pool);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(-1000.0f, 1000.0f);
-
-        for (int j = 0; j < num_rows; ++j) {
-            ARROW_RETURN_NOT_OK(builder.Append(static_cast<float>(dis(gen))));
-        }
-
-        std::shared_ptr<arrow::Array> array;
-        ARROW_RETURN_NOT_OK(builder.Finish(&array));
-        arrays.push_back(array);
-    }
-
-    auto schema = std::make_shared<arrow::Schema>(schema_vector);
-    auto table = arrow::Table::Make(schema, arrays);
+    ARROW_ASSIGN_OR_RAISE(auto table, GenerateTable(num_columns, num_rows, pool));
 
     // Write the table to a Parquet file
     std::shared_ptr<arrow::io::FileOutputStream> outfile;
@@ -44,7 +26,12 @@ arrow::Status WriteParquetFile(int num_columns, int num_rows, const std::string&
     return arrow::Status::OK();
 }
 
-int main() {
+int main(int argc, char** argv) {
+    auto flag_status = ParseBenchmarkFlags(&argc, argv);
+    if (!flag_status.ok()) {
+        std::cerr << flag_status.ToString() << std::endl;
+        return 1;
+    }
     std::vector<int> column_counts = {10, 100, 1000, 10000};
     int num_rows = 10000;  // Adjust as needed
 